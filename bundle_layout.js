@@ -0,0 +1,77 @@
+#!/usr/bin/env node
+
+// Builds the single page the editor loads: layout.html with the compiled CSS and the
+// title font inlined, whitespace and comments stripped, and optionally gzip-compressed.
+// The plugin serves the result straight from BinaryData, so opening the editor does
+// no string work.
+//
+// Usage: node bundle_layout.js [--gzip]
+
+const fs = require("fs");
+const path = require("path");
+const zlib = require("zlib");
+
+const resources = path.join(__dirname, "src", "resources");
+const htmlPath = path.join(resources, "layout.html");
+const cssPath = path.join(resources, "layout.css");
+const fontPath = path.join(resources, "fonts", "old_english_hearts.ttf");
+const outputPath = path.join(resources, "layout.bundle.html");
+
+const fontReference = /url\(\s*["']?BinaryData::old_english_hearts_ttf["']?\s*\)/g;
+const stylesheetLink = '<link rel="stylesheet" href="./layout.css" />';
+
+function fail(message) {
+  console.error("ERROR: " + message);
+  process.exit(1);
+}
+
+for (const file of [htmlPath, cssPath, fontPath]) {
+  if (!fs.existsSync(file)) fail(file + " not found");
+}
+
+let html = fs.readFileSync(htmlPath, "utf8");
+const css = fs.readFileSync(cssPath, "utf8");
+const fontUrl =
+  "url(data:font/ttf;base64," + fs.readFileSync(fontPath).toString("base64") + ")";
+
+if (!html.includes(stylesheetLink)) fail("stylesheet link missing from layout.html");
+
+// Inline the stylesheet, then point every reference to the font at the embedded copy
+html = html.replace(stylesheetLink, () => "<style>" + css + "</style>");
+html = html.replace(fontReference, () => fontUrl);
+
+// Strip indentation, blank lines and comments. Line breaks are kept so JavaScript
+// relying on automatic semicolon insertion still parses; only whole-line // comments
+// are removed inside scripts, which is always safe.
+let inScript = false;
+const lines = [];
+
+for (const rawLine of html.split(/\r?\n/)) {
+  const line = rawLine.trim();
+
+  if (/<script\b/.test(line)) inScript = true;
+  const closesScript = /<\/script>/.test(line);
+
+  const keep =
+    line.length > 0 && !(inScript && !closesScript && line.startsWith("//"));
+
+  if (keep) lines.push(line);
+  if (closesScript) inScript = false;
+}
+
+const minified = lines.join("\n").replace(/<!--[\s\S]*?-->/g, "");
+
+const compress = process.argv.includes("--gzip");
+const output = compress
+  ? zlib.gzipSync(Buffer.from(minified, "utf8"), { level: 9 })
+  : Buffer.from(minified, "utf8");
+
+fs.writeFileSync(outputPath, output);
+console.log(
+  "Bundled layout: " +
+    output.length +
+    " bytes" +
+    (compress ? " (gzip)" : "") +
+    " -> " +
+    path.relative(__dirname, outputPath)
+);
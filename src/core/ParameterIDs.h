@@ -0,0 +1,41 @@
+#pragma once
+
+#include <array>
+
+// Parameter IDs shared by the processor, the UI bridge and the preset manager
+namespace ParameterIDs
+{
+    // Distortion
+    inline constexpr const char *drive = "drive";
+    inline constexpr const char *mix = "mix";
+    inline constexpr const char *inputGain = "inputGain";
+    inline constexpr const char *outputGain = "outputGain";
+    inline constexpr const char *algorithm = "algorithm";
+    inline constexpr const char *oversampling = "oversampling";
+
+    // Delay
+    inline constexpr const char *delayTime = "delayTime";
+    inline constexpr const char *delayFeedback = "delayFeedback";
+    inline constexpr const char *delayMix = "delayMix";
+    inline constexpr const char *pingPong = "pingPong";
+    inline constexpr const char *delaySync = "delaySync";
+    inline constexpr const char *delayNote = "delayNote";
+
+    // Filter
+    inline constexpr const char *filterType = "filterType";
+    inline constexpr const char *filterFrequency = "filterFrequency";
+    inline constexpr const char *filterResonance = "filterResonance";
+
+    // Pulse
+    inline constexpr const char *pulseMix = "pulseMix";
+    inline constexpr const char *pulseRate = "pulseRate";
+
+    // Numeric IDs for the UI bridge: the page refers to a parameter by its index here.
+    // The list is handed to the page at startup, so the order only has to be stable
+    // within one session.
+    inline constexpr std::array<const char *, 17> bridgeOrder = {
+        drive, mix, inputGain, outputGain, algorithm, oversampling,
+        delayTime, delayFeedback, delayMix, pingPong, delaySync, delayNote,
+        filterType, filterFrequency, filterResonance,
+        pulseMix, pulseRate};
+}
@@ -4,121 +4,157 @@
 OxideAudioProcessorEditor::OxideAudioProcessorEditor(OxideAudioProcessor &p)
     : AudioProcessorEditor(&p),
       audioProcessor(p),
-      layoutView(p.getDistortionProcessor(), p.getDelayProcessor(), p.getFilterProcessor(), p.getPulseProcessor()),
-      presetLoadRefreshCounter(0)
+      frameScheduler(*this)
 {
     addAndMakeVisible(background);
-    addAndMakeVisible(layoutView);
 
-    // Initialize the layout view with the output buffer for oscilloscope
-    layoutView.updateBuffer(p.getOutputBuffer());
+    // Any parameter change, from the view, the host or a preset, marks the next frame dirty
+    for (const auto *parameterId : ParameterIDs::bridgeOrder)
+        audioProcessor.getParameters().addParameterListener(parameterId, this);
 
-    // Get the PresetManager safely
-    auto *presetManager = audioProcessor.getPresetManager();
+    frameScheduler.onFrame = [this](double elapsedSeconds)
+    { renderFrame(elapsedSeconds); };
 
-    // Set up preset selection callback
-    layoutView.onPresetSelected = [this](const juce::String &presetName)
+    // Open the way this instance was last left
+    createView(audioProcessor.getUseNativeEditor());
+
+    // Presets saved by other instances, or copied into the folder, show up without a reopen
+    if (auto *presetManager = audioProcessor.getPresetManager())
     {
-        // Get the PresetManager safely
-        auto *presetManager = audioProcessor.getPresetManager();
-        if (presetManager && presetManager->loadPreset(presetName))
-        {
-            updateUIAfterPresetLoad();
+        presetManager->onPresetListChanged = [this]()
+        { view->updatePresetList(getPresetNames()); };
 
-            // Start a separate timer for multiple refresh attempts after preset loading
-            presetLoadRefreshCounter = 0;
-            startTimer(50); // Refresh UI after a short delay
-        }
-    };
+        presetManager->onPresetLoaded = [this](const juce::String &)
+        { updateUIAfterPresetLoad(); };
+    }
+
+    // Set initial size
+    setSize(CANVAS_WIDTH, CANVAS_HEIGHT);
+}
+
+void OxideAudioProcessorEditor::createView(bool useNativeView)
+{
+    // The old view goes first, so two web engines never run side by side
+    view = nullptr;
 
-    // Update the preset dropdown with available presets
-    if (presetManager != nullptr)
+    if (useNativeView)
     {
-        layoutView.updatePresetList(presetManager->getPresetList());
+        view = std::make_unique<NativeView>(audioProcessor.getParameters(), audioProcessor.getFilterProcessor(),
+                                            audioProcessor.getPulseProcessor(), audioProcessor.getScopeFifo());
     }
     else
     {
-        // Provide a default preset list if PresetManager isn't available
-        juce::StringArray defaultList;
-        defaultList.add("Default");
-        layoutView.updatePresetList(defaultList);
+        auto layoutView = std::make_unique<LayoutView>(audioProcessor.getParameters(), audioProcessor.getFilterProcessor(),
+                                                       audioProcessor.getPulseProcessor(), audioProcessor.getScopeFifo());
+
+        // Every control goes through the same parameter path as host automation
+        layoutView->onParameterChanged = [this](const juce::String &parameterId, float plainValue)
+        {
+            audioProcessor.setParameterValue(parameterId, plainValue);
+        };
+
+        view = std::move(layoutView);
     }
 
-    layoutView.onSaveClicked = [this]()
+    // Set up preset selection callback
+    view->onPresetSelected = [this](const juce::String &presetName)
     {
-        // Get the PresetManager safely
-        auto *presetManager = audioProcessor.getPresetManager();
-        if (presetManager == nullptr)
-        {
-            return;
-        }
+        // The preset loads in the background; onPresetLoaded follows once it is applied
+        if (auto *presetManager = audioProcessor.getPresetManager())
+            presetManager->loadPreset(presetName);
+    };
+
+    view->onSaveClicked = [this]()
+    { showSaveDialog(); };
 
-        // Use asynchronous alert window
-        auto saveDialog = std::make_unique<juce::AlertWindow>(
-            "Save Preset", "Enter a name for this preset:", juce::AlertWindow::QuestionIcon);
+    view->onSwitchViewClicked = [this]()
+    {
+        // The request comes from inside the view, so replace it once that call has returned
+        juce::Component::SafePointer<OxideAudioProcessorEditor> editor(this);
+        juce::MessageManager::callAsync([editor]()
+                                        {
+                                            if (editor != nullptr)
+                                                editor->switchView();
+                                        });
+    };
 
-        saveDialog->addTextEditor("presetName", "New Preset", "Preset Name:");
-        saveDialog->addButton("Save", 1, juce::KeyPress(juce::KeyPress::returnKey));
-        saveDialog->addButton("Cancel", 0, juce::KeyPress(juce::KeyPress::escapeKey));
+    view->updatePresetList(getPresetNames());
 
-        // Use lambdas carefully to avoid capturing this pointer across threads
-        auto *pm = presetManager;
-        auto &lv = layoutView;
+    addAndMakeVisible(*view);
+    view->setBounds(getLocalBounds());
+    parametersDirty = true;
+}
 
-        saveDialog->enterModalState(true, juce::ModalCallbackFunction::create(
-                                              [pm, &lv, saveDialogPtr = saveDialog.release()](int result)
-                                              {
-                                                  std::unique_ptr<juce::AlertWindow> ownedDialog(saveDialogPtr);
+void OxideAudioProcessorEditor::switchView()
+{
+    const bool useNativeView = !audioProcessor.getUseNativeEditor();
+    audioProcessor.setUseNativeEditor(useNativeView);
+    createView(useNativeView);
+}
 
-                                                  if (result == 1)
-                                                  {
-                                                      juce::String presetName = ownedDialog->getTextEditorContents("presetName");
-                                                      if (presetName.isNotEmpty())
-                                                      {
-                                                          pm->savePreset(presetName);
-
-                                                          // Update the preset dropdown with the new list
-                                                          lv.updatePresetList(pm->getPresetList());
-                                                      }
-                                                  }
-                                              }));
-    };
+juce::StringArray OxideAudioProcessorEditor::getPresetNames()
+{
+    if (auto *presetManager = audioProcessor.getPresetManager())
+        return presetManager->getPresetList();
 
-    // Set up callbacks for input/output gain changes from the UI
-    layoutView.onInputGainChanged = [this](float newGain)
-    {
-        audioProcessor.getDistortionProcessor().setInputGain(newGain);
-    };
+    // Provide a default preset list if PresetManager isn't available
+    juce::StringArray defaultList;
+    defaultList.add("Default");
+    return defaultList;
+}
 
-    layoutView.onOutputGainChanged = [this](float newGain)
+void OxideAudioProcessorEditor::showSaveDialog()
+{
+    // Get the PresetManager safely
+    auto *presetManager = audioProcessor.getPresetManager();
+    if (presetManager == nullptr)
     {
-        audioProcessor.getDistortionProcessor().setOutputGain(newGain);
-    };
+        return;
+    }
 
-    // Initialize with the current gain values
-    layoutView.setInputGain(audioProcessor.getDistortionProcessor().getInputGain());
-    layoutView.setOutputGain(audioProcessor.getDistortionProcessor().getOutputGain());
+    // Use asynchronous alert window
+    auto saveDialog = std::make_unique<juce::AlertWindow>(
+        "Save Preset", "Enter a name for this preset:", juce::AlertWindow::QuestionIcon);
 
-    // Start the timer for meter updates
-    startTimerHz(30);
+    saveDialog->addTextEditor("presetName", "New Preset", "Preset Name:");
+    saveDialog->addButton("Save", 1, juce::KeyPress(juce::KeyPress::returnKey));
+    saveDialog->addButton("Cancel", 0, juce::KeyPress(juce::KeyPress::escapeKey));
 
-    // Set initial size
-    setSize(CANVAS_WIDTH, CANVAS_HEIGHT);
+    auto *pm = presetManager;
+
+    saveDialog->enterModalState(true, juce::ModalCallbackFunction::create(
+                                          [pm, saveDialogPtr = saveDialog.release()](int result)
+                                          {
+                                              std::unique_ptr<juce::AlertWindow> ownedDialog(saveDialogPtr);
+
+                                              if (result == 1)
+                                              {
+                                                  juce::String presetName = ownedDialog->getTextEditorContents("presetName");
+                                                  if (presetName.isNotEmpty())
+                                                  {
+                                                      // The index reports the new file, which refreshes the dropdown
+                                                      pm->savePreset(presetName);
+                                                  }
+                                              }
+                                          }));
 }
 
 void OxideAudioProcessorEditor::updateUIAfterPresetLoad()
 {
-    // Update the input/output gain display
-    layoutView.setInputGain(audioProcessor.getDistortionProcessor().getInputGain());
-    layoutView.setOutputGain(audioProcessor.getDistortionProcessor().getOutputGain());
-
     // Force a refresh of all UI parameters
-    layoutView.refreshAllParameters();
+    view->refreshAllParameters();
 }
 
 OxideAudioProcessorEditor::~OxideAudioProcessorEditor()
 {
-    stopTimer();
+    for (const auto *parameterId : ParameterIDs::bridgeOrder)
+        audioProcessor.getParameters().removeParameterListener(parameterId, this);
+
+    if (auto *presetManager = audioProcessor.getPresetManager())
+    {
+        presetManager->onPresetListChanged = nullptr;
+        presetManager->onPresetLoaded = nullptr;
+    }
 }
 
 void OxideAudioProcessorEditor::paint(juce::Graphics &g)
@@ -133,67 +169,80 @@ void OxideAudioProcessorEditor::resized()
     // Set the background to cover the entire window
     background.setBounds(bounds);
 
-    // Set the layout view to cover the entire window as well
-    layoutView.setBounds(bounds);
+    // The view covers the entire window as well
+    if (view != nullptr)
+        view->setBounds(bounds);
+}
+
+void OxideAudioProcessorEditor::renderFrame(double elapsedSeconds)
+{
+    updateMeters(static_cast<float>(elapsedSeconds));
+    view->renderFrame(parametersDirty.exchange(false));
+}
+
+void OxideAudioProcessorEditor::parameterChanged(const juce::String &, float)
+{
+    // May arrive on the audio thread during automation
+    parametersDirty = true;
+}
+
+void OxideAudioProcessorEditor::MeterBallistics::update(float rms, float peak, float elapsedSeconds)
+{
+    // 20 dB per second, however often frames arrive
+    constexpr float releaseDbPerSecond = 20.0f;
+    constexpr float holdSeconds = 1.0f;
+
+    const float releaseFactor = juce::Decibels::decibelsToGain(-releaseDbPerSecond * elapsedSeconds);
+
+    level = rms > level ? rms : level * releaseFactor;
+
+    if (peak >= hold)
+    {
+        hold = peak;
+        holdSecondsLeft = holdSeconds;
+    }
+    else if (holdSecondsLeft > 0.0f)
+    {
+        holdSecondsLeft -= elapsedSeconds;
+    }
+    else
+    {
+        hold *= releaseFactor;
+    }
 }
 
-void OxideAudioProcessorEditor::timerCallback()
+void OxideAudioProcessorEditor::updateMeters(float elapsedSeconds)
 {
-    // If in preset loading mode, do additional refreshes
-    if (presetLoadRefreshCounter >= 0 && presetLoadRefreshCounter < 5)
+    // Input gain is applied inside the distortion stage, so scale the input readings
+    // to match what the signal chain actually sees
+    const float inputGainLinear = juce::Decibels::decibelsToGain(audioProcessor.getDistortionProcessor().getInputGain());
+
+    for (int channel = 0; channel < MeterProcessor::maxChannels; ++channel)
     {
-        // Force multiple UI refreshes after preset loading
-        layoutView.refreshAllParameters();
-        presetLoadRefreshCounter++;
+        const auto input = audioProcessor.getInputMeter().read(channel);
+        const auto output = audioProcessor.getOutputMeter().read(channel);
 
-        if (presetLoadRefreshCounter >= 5)
-        {
-            // Reset counter and return to normal update frequency
-            presetLoadRefreshCounter = -1;
-            stopTimer();
-            startTimerHz(30);
-        }
+        meterBallistics[static_cast<size_t>(channel)].update(input.rms * inputGainLinear, input.truePeak * inputGainLinear, elapsedSeconds);
+        meterBallistics[static_cast<size_t>(channel + 2)].update(output.rms, output.truePeak, elapsedSeconds);
+    }
 
-        // Skip the regular updates during preset loading refresh cycle
-        return;
+    // Convert to bar heights; small values show as completely empty
+    auto toDisplayHeight = [](float level)
+    {
+        const float height = juce::jlimit(0.0f, 100.0f, std::sqrt(level) * 100.0f);
+        return height < 0.1f ? 0.0f : height;
+    };
+
+    EditorView::MeterLevels levels;
+
+    for (size_t i = 0; i < meterBallistics.size(); ++i)
+    {
+        levels.bar[i] = toDisplayHeight(meterBallistics[i].level);
+        levels.hold[i] = toDisplayHeight(meterBallistics[i].hold);
     }
 
-    // Regular meter updates
-    float leftLevel = audioProcessor.getLeftLevel();
-    float rightLevel = audioProcessor.getRightLevel();
-    float outLeftLevel = audioProcessor.getOutputLeftLevel();
-    float outRightLevel = audioProcessor.getOutputRightLevel();
-
-    // Apply input gain to the displayed levels to match the actual processing
-    float inputGainLinear = std::pow(10.0f, audioProcessor.getDistortionProcessor().getInputGain() / 20.0f);
-    leftLevel *= inputGainLinear;
-    rightLevel *= inputGainLinear;
-
-    // Scale for display - convert RMS values to percentage heights
-    leftLevel = std::pow(leftLevel * 100.0f, 0.5f) * 10.0f;
-    rightLevel = std::pow(rightLevel * 100.0f, 0.5f) * 10.0f;
-    outLeftLevel = std::pow(outLeftLevel * 100.0f, 0.5f) * 10.0f;
-    outRightLevel = std::pow(outRightLevel * 100.0f, 0.5f) * 10.0f;
-
-    // Ensure values are in range
-    leftLevel = juce::jlimit(0.0f, 100.0f, leftLevel);
-    rightLevel = juce::jlimit(0.0f, 100.0f, rightLevel);
-    outLeftLevel = juce::jlimit(0.0f, 100.0f, outLeftLevel);
-    outRightLevel = juce::jlimit(0.0f, 100.0f, outRightLevel);
-
-    // Allow small values to show as completely empty
-    if (leftLevel < 0.1f)
-        leftLevel = 0.0f;
-    if (rightLevel < 0.1f)
-        rightLevel = 0.0f;
-    if (outLeftLevel < 0.1f)
-        outLeftLevel = 0.0f;
-    if (outRightLevel < 0.1f)
-        outRightLevel = 0.0f;
-
-    // Update the levels in the layout view
-    layoutView.updateLevels(leftLevel, rightLevel, outLeftLevel, outRightLevel);
-
-    // Update the oscilloscope with latest audio buffer
-    layoutView.updateBuffer(audioProcessor.getOutputBuffer());
-}
\ No newline at end of file
+    const float outputTruePeak = juce::jmax(meterBallistics[2].hold, meterBallistics[3].hold);
+    levels.outputTruePeakDb = juce::Decibels::gainToDecibels(outputTruePeak, EditorView::MeterLevels::silenceDb);
+
+    view->updateLevels(levels);
+}
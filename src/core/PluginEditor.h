@@ -3,10 +3,12 @@
 #include <JuceHeader.h>
 #include "PluginProcessor.h"
 #include "LayoutView.h"
+#include "NativeView.h"
 #include "Background.h"
+#include "FrameScheduler.h"
 
 class OxideAudioProcessorEditor : public juce::AudioProcessorEditor,
-                                  private juce::Timer
+                                  private juce::AudioProcessorValueTreeState::Listener
 {
 public:
     static constexpr int CANVAS_WIDTH = 720;
@@ -22,12 +24,42 @@ private:
     OxideAudioProcessor &audioProcessor;
 
     Background background;
-    LayoutView layoutView;
 
-    // Counter for multiple UI refreshes after preset loading
-    int presetLoadRefreshCounter = -1;
+    // Either the web page or the native view, chosen per instance and swappable while open
+    std::unique_ptr<EditorView> view;
 
-    void timerCallback() override;
+    // The single place UI work is scheduled from
+    FrameScheduler frameScheduler;
+
+    // Set by parameter changes from any thread, consumed by the next frame
+    std::atomic<bool> parametersDirty{true};
+
+    // Meter display ballistics for one channel, advanced once per frame
+    struct MeterBallistics
+    {
+        float level = 0.0f; // Bar: follows rises at once, falls at a steady dB rate
+        float hold = 0.0f;  // Peak marker: held for a second, then falls like the bar
+        float holdSecondsLeft = 0.0f;
+
+        void update(float rms, float peak, float elapsedSeconds);
+    };
+
+    // Input left/right, then output left/right
+    std::array<MeterBallistics, 4> meterBallistics;
+
+    void updateMeters(float elapsedSeconds);
+
+    // One UI frame: meters, then whatever changed goes to the view
+    void renderFrame(double elapsedSeconds);
+
+    // Replaces the current view and wires it up
+    void createView(bool useNativeView);
+    void switchView();
+
+    juce::StringArray getPresetNames();
+    void showSaveDialog();
+
+    void parameterChanged(const juce::String &parameterId, float newValue) override;
     void updateUIAfterPresetLoad();
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(OxideAudioProcessorEditor)
@@ -2,22 +2,267 @@
 #include "PluginEditor.h"
 #include "PresetManager.h"
 
+namespace
+{
+    // Editor choice, stored as a property of the parameter tree rather than a parameter
+    // so the host never sees or automates it
+    const juce::Identifier nativeEditorProperty{"nativeEditor"};
+}
+
 OxideAudioProcessor::OxideAudioProcessor()
     : AudioProcessor(BusesProperties()
                          .withInput("Input", juce::AudioChannelSet::stereo(), true)
                          .withOutput("Output", juce::AudioChannelSet::stereo(), true)),
+      parameters(*this, nullptr, "OxideParameters", createParameterLayout()),
       presetManagerInitialized(false)
 {
+    // Cache the raw parameter atomics so processBlock never looks them up by name
+    parameterPointers.drive = parameters.getRawParameterValue(ParameterIDs::drive);
+    parameterPointers.mix = parameters.getRawParameterValue(ParameterIDs::mix);
+    parameterPointers.inputGain = parameters.getRawParameterValue(ParameterIDs::inputGain);
+    parameterPointers.outputGain = parameters.getRawParameterValue(ParameterIDs::outputGain);
+    parameterPointers.algorithm = parameters.getRawParameterValue(ParameterIDs::algorithm);
+    parameterPointers.oversampling = parameters.getRawParameterValue(ParameterIDs::oversampling);
+    parameterPointers.delayTime = parameters.getRawParameterValue(ParameterIDs::delayTime);
+    parameterPointers.delayFeedback = parameters.getRawParameterValue(ParameterIDs::delayFeedback);
+    parameterPointers.delayMix = parameters.getRawParameterValue(ParameterIDs::delayMix);
+    parameterPointers.pingPong = parameters.getRawParameterValue(ParameterIDs::pingPong);
+    parameterPointers.delaySync = parameters.getRawParameterValue(ParameterIDs::delaySync);
+    parameterPointers.delayNote = parameters.getRawParameterValue(ParameterIDs::delayNote);
+    parameterPointers.filterType = parameters.getRawParameterValue(ParameterIDs::filterType);
+    parameterPointers.filterFrequency = parameters.getRawParameterValue(ParameterIDs::filterFrequency);
+    parameterPointers.filterResonance = parameters.getRawParameterValue(ParameterIDs::filterResonance);
+    parameterPointers.pulseMix = parameters.getRawParameterValue(ParameterIDs::pulseMix);
+    parameterPointers.pulseRate = parameters.getRawParameterValue(ParameterIDs::pulseRate);
+
+    parameters.addParameterListener(ParameterIDs::oversampling, this);
+
     // Defer PresetManager initialization to avoid constructor issues
     // It will be created on first access via getPresetManager()
 }
 
 OxideAudioProcessor::~OxideAudioProcessor()
 {
+    parameters.removeParameterListener(ParameterIDs::oversampling, this);
+    cancelPendingUpdate();
+
     // Destroy preset manager first (it has a reference to this processor)
     presetManager.reset();
 }
 
+juce::AudioProcessorValueTreeState::ParameterLayout OxideAudioProcessor::createParameterLayout()
+{
+    juce::AudioProcessorValueTreeState::ParameterLayout layout;
+
+    // Distortion
+    layout.add(std::make_unique<juce::AudioParameterFloat>(
+        juce::ParameterID{ParameterIDs::drive, 1}, "Drive", juce::NormalisableRange<float>(0.0f, 1.0f), 0.5f));
+    layout.add(std::make_unique<juce::AudioParameterFloat>(
+        juce::ParameterID{ParameterIDs::mix, 1}, "Distortion Mix", juce::NormalisableRange<float>(0.0f, 1.0f), 0.5f));
+    layout.add(std::make_unique<juce::AudioParameterFloat>(
+        juce::ParameterID{ParameterIDs::inputGain, 1}, "Input Gain", juce::NormalisableRange<float>(-12.0f, 12.0f), 0.0f));
+    layout.add(std::make_unique<juce::AudioParameterFloat>(
+        juce::ParameterID{ParameterIDs::outputGain, 1}, "Output Gain", juce::NormalisableRange<float>(-12.0f, 12.0f), 0.0f));
+    layout.add(std::make_unique<juce::AudioParameterChoice>(
+        juce::ParameterID{ParameterIDs::algorithm, 1}, "Algorithm", DistortionProcessor::getAlgorithmNames(), 0));
+    layout.add(std::make_unique<juce::AudioParameterChoice>(
+        juce::ParameterID{ParameterIDs::oversampling, 1}, "Oversampling", DistortionProcessor::getOversamplingNames(), 0));
+
+    // Delay
+    juce::NormalisableRange<float> delayTimeRange(0.01f, 2.0f);
+    delayTimeRange.setSkewForCentre(0.5f);
+    layout.add(std::make_unique<juce::AudioParameterFloat>(
+        juce::ParameterID{ParameterIDs::delayTime, 1}, "Delay Time", delayTimeRange, 0.5f));
+    layout.add(std::make_unique<juce::AudioParameterFloat>(
+        juce::ParameterID{ParameterIDs::delayFeedback, 1}, "Delay Feedback", juce::NormalisableRange<float>(0.0f, 1.0f), 0.4f));
+    layout.add(std::make_unique<juce::AudioParameterFloat>(
+        juce::ParameterID{ParameterIDs::delayMix, 1}, "Delay Mix", juce::NormalisableRange<float>(0.0f, 1.0f), 0.3f));
+    layout.add(std::make_unique<juce::AudioParameterBool>(
+        juce::ParameterID{ParameterIDs::pingPong, 1}, "Ping Pong", false));
+    layout.add(std::make_unique<juce::AudioParameterBool>(
+        juce::ParameterID{ParameterIDs::delaySync, 1}, "Delay Sync", false));
+    layout.add(std::make_unique<juce::AudioParameterChoice>(
+        juce::ParameterID{ParameterIDs::delayNote, 1}, "Delay Note", DelayProcessor::getNoteValueNames(), 7));
+
+    // Filter
+    juce::NormalisableRange<float> frequencyRange(20.0f, 20000.0f);
+    frequencyRange.setSkewForCentre(1000.0f);
+    juce::NormalisableRange<float> resonanceRange(0.1f, 10.0f);
+    resonanceRange.setSkewForCentre(1.0f);
+    layout.add(std::make_unique<juce::AudioParameterChoice>(
+        juce::ParameterID{ParameterIDs::filterType, 1}, "Filter Type", FilterProcessor::getFilterTypeNames(), 0));
+    layout.add(std::make_unique<juce::AudioParameterFloat>(
+        juce::ParameterID{ParameterIDs::filterFrequency, 1}, "Filter Frequency", frequencyRange, 1000.0f));
+    layout.add(std::make_unique<juce::AudioParameterFloat>(
+        juce::ParameterID{ParameterIDs::filterResonance, 1}, "Filter Resonance", resonanceRange, 0.7f));
+
+    // Pulse
+    layout.add(std::make_unique<juce::AudioParameterFloat>(
+        juce::ParameterID{ParameterIDs::pulseMix, 1}, "Pulse Amount", juce::NormalisableRange<float>(0.0f, 1.0f), 0.0f));
+    layout.add(std::make_unique<juce::AudioParameterChoice>(
+        juce::ParameterID{ParameterIDs::pulseRate, 1}, "Pulse Rate", PulseProcessor::getRateNames(), 1));
+
+    return layout;
+}
+
+void OxideAudioProcessor::setParameterValue(const juce::String &parameterId, float plainValue)
+{
+    if (auto *parameter = parameters.getParameter(parameterId))
+        parameter->setValueNotifyingHost(parameter->convertTo0to1(plainValue));
+
+    // While audio runs, the next block takes the change (behind the swap fade if one is
+    // under way). Otherwise nothing would, so keep UI reads of the stages current here.
+    if (!audioPrepared.load())
+        syncProcessorsWithParameters();
+}
+
+bool OxideAudioProcessor::getUseNativeEditor() const
+{
+    return parameters.state.getProperty(nativeEditorProperty, false);
+}
+
+void OxideAudioProcessor::setUseNativeEditor(bool shouldUseNativeEditor)
+{
+    parameters.state.setProperty(nativeEditorProperty, shouldUseNativeEditor, nullptr);
+}
+
+void OxideAudioProcessor::applyPresetState(const PresetState &state)
+{
+    beginStateWrite();
+
+    for (size_t i = 0; i < PresetState::numParameters; ++i)
+    {
+        auto *parameter = parameters.getParameter(ParameterIDs::bridgeOrder[i]);
+        if (parameter == nullptr)
+            continue;
+
+        const float normalisedValue = parameter->convertTo0to1(state.values[i]);
+        if (parameter->getValue() != normalisedValue)
+            parameter->setValueNotifyingHost(normalisedValue);
+    }
+
+    endStateWrite();
+}
+
+void OxideAudioProcessor::beginStateWrite()
+{
+    stateWriteSequence.fetch_add(1, std::memory_order_acq_rel);
+}
+
+void OxideAudioProcessor::endStateWrite()
+{
+    stateWriteSequence.fetch_add(1, std::memory_order_release);
+
+    // Nothing is processing, so there is no fade to wait for; keep the stages current
+    // for the UI
+    if (!audioPrepared.load())
+        syncProcessorsWithParameters();
+}
+
+void OxideAudioProcessor::syncProcessorsWithParameters()
+{
+    applyParameterSnapshot(readParameterSnapshot());
+}
+
+OxideAudioProcessor::ParameterSnapshot OxideAudioProcessor::readParameterSnapshot() const
+{
+    const auto &p = parameterPointers;
+    ParameterSnapshot snapshot;
+
+    snapshot.drive = p.drive->load();
+    snapshot.mix = p.mix->load();
+    snapshot.inputGain = p.inputGain->load();
+    snapshot.outputGain = p.outputGain->load();
+    snapshot.algorithm = p.algorithm->load();
+    snapshot.oversampling = p.oversampling->load();
+
+    snapshot.delayTime = p.delayTime->load();
+    snapshot.delayFeedback = p.delayFeedback->load();
+    snapshot.delayMix = p.delayMix->load();
+    snapshot.pingPong = p.pingPong->load();
+    snapshot.delaySync = p.delaySync->load();
+    snapshot.delayNote = p.delayNote->load();
+
+    snapshot.filterType = p.filterType->load();
+    snapshot.filterFrequency = p.filterFrequency->load();
+    snapshot.filterResonance = p.filterResonance->load();
+
+    snapshot.pulseMix = p.pulseMix->load();
+    snapshot.pulseRate = p.pulseRate->load();
+
+    return snapshot;
+}
+
+void OxideAudioProcessor::applyParameterSnapshot(const ParameterSnapshot &snapshot)
+{
+    distortionProcessor.setDrive(snapshot.drive);
+    distortionProcessor.setMix(snapshot.mix);
+    distortionProcessor.setInputGain(snapshot.inputGain);
+    distortionProcessor.setOutputGain(snapshot.outputGain);
+    distortionProcessor.setAlgorithm(static_cast<DistortionAlgorithm>(juce::roundToInt(snapshot.algorithm)));
+
+    appliedOversampling = juce::jlimit(0, 3, juce::roundToInt(snapshot.oversampling));
+    distortionProcessor.setOversampling(static_cast<OversamplingFactor>(appliedOversampling));
+
+    delayProcessor.setDelayTime(snapshot.delayTime);
+    delayProcessor.setFeedback(snapshot.delayFeedback);
+    delayProcessor.setMix(snapshot.delayMix);
+    delayProcessor.setPingPong(snapshot.pingPong >= 0.5f);
+    delayProcessor.setSync(snapshot.delaySync >= 0.5f);
+    delayProcessor.setNoteValue(juce::roundToInt(snapshot.delayNote));
+
+    filterProcessor.setFilterType(static_cast<FilterType>(juce::roundToInt(snapshot.filterType)));
+    filterProcessor.setFrequency(snapshot.filterFrequency);
+    filterProcessor.setResonance(snapshot.filterResonance);
+
+    pulseProcessor.setMix(snapshot.pulseMix);
+    pulseProcessor.setRate(static_cast<Rate>(juce::roundToInt(snapshot.pulseRate)));
+}
+
+void OxideAudioProcessor::syncProcessorsForBlock()
+{
+    const auto sequence = stateWriteSequence.load(std::memory_order_acquire);
+    auto snapshot = readParameterSnapshot();
+
+    // A whole-state write has started since the last swap, or a read overlapped one, or
+    // the oversampling factor changed: keep the old settings and fade out
+    const bool torn = stateWriteSequence.load(std::memory_order_acquire) != sequence;
+    const bool oversamplingChanged = juce::jlimit(0, 3, juce::roundToInt(snapshot.oversampling)) != appliedOversampling;
+
+    if ((sequence != appliedStateSequence || torn || oversamplingChanged) && !swapFade.isFadingOut())
+        swapFade.beginFadeOut();
+
+    if (!swapFade.isFadingOut())
+    {
+        // Single parameter changes (automation, the UI) go straight through
+        applyParameterSnapshot(snapshot);
+        return;
+    }
+
+    // Swap once the output is silent and the write has finished; if another write
+    // started while reading, stay silent and try again next block
+    if (!swapFade.isSilent() || (sequence & 1) != 0 || torn)
+        return;
+
+    applyParameterSnapshot(snapshot);
+    appliedStateSequence = sequence;
+    swapFade.beginFadeIn();
+}
+
+void OxideAudioProcessor::parameterChanged(const juce::String &parameterId, float)
+{
+    // May arrive on the audio thread; the new factor itself reaches the distortion stage
+    // through the block snapshot
+    if (parameterId == ParameterIDs::oversampling)
+        triggerAsyncUpdate();
+}
+
+void OxideAudioProcessor::handleAsyncUpdate()
+{
+    const int factor = juce::jlimit(0, 3, juce::roundToInt(parameterPointers.oversampling->load()));
+    setLatencySamples(distortionProcessor.getLatencySamples(static_cast<OversamplingFactor>(factor)));
+}
+
 PresetManager *OxideAudioProcessor::getPresetManager()
 {
     // Lazy initialization of the PresetManager to avoid constructor issues
@@ -87,24 +332,41 @@ void OxideAudioProcessor::changeProgramName(int index, const juce::String &newNa
 
 void OxideAudioProcessor::prepareToPlay(double sampleRate, int samplesPerBlock)
 {
-    levelLeft.reset(sampleRate, 0.1); // Smooth over 100ms
-    levelRight.reset(sampleRate, 0.1);
-    outputLevelLeft.reset(sampleRate, 0.1);
-    outputLevelRight.reset(sampleRate, 0.1);
+    // Start every stage from the current parameter values, with no swap pending
+    syncProcessorsWithParameters();
+    appliedStateSequence = stateWriteSequence.load(std::memory_order_acquire) & ~1u;
+    swapFade.prepare(sampleRate);
+
+    // Size all audio-thread scratch memory up front so processBlock never allocates
+    const int numChannels = juce::jmax(getTotalNumInputChannels(), getTotalNumOutputChannels());
+    scratchArena.prepare(numChannels, samplesPerBlock);
+    scopeFifo.prepare();
 
     // Prepare DSP components in signal chain order
     delayProcessor.prepare(sampleRate, samplesPerBlock);
-    distortionProcessor.prepare(sampleRate);
+    distortionProcessor.prepare(sampleRate, samplesPerBlock);
     filterProcessor.prepare(sampleRate, samplesPerBlock);
     pulseProcessor.prepare(sampleRate, samplesPerBlock);
+
+    inputMeter.prepare(sampleRate, samplesPerBlock);
+    outputMeter.prepare(sampleRate, samplesPerBlock);
+
+    // Oversampling is the only stage that adds latency
+    setLatencySamples(distortionProcessor.getLatencySamples());
+
+    audioPrepared = true;
 }
 
 void OxideAudioProcessor::releaseResources()
 {
+    audioPrepared = false;
+
     // When playback stops, release all resources
     delayProcessor.reset();
     filterProcessor.reset();
     pulseProcessor.reset();
+    inputMeter.reset();
+    outputMeter.reset();
 }
 
 bool OxideAudioProcessor::isBusesLayoutSupported(const BusesLayout &layouts) const
@@ -126,59 +388,64 @@ void OxideAudioProcessor::processBlock(juce::AudioBuffer<float> &buffer, juce::M
     auto totalNumInputChannels = getTotalNumInputChannels();
     auto totalNumOutputChannels = getTotalNumOutputChannels();
 
+    // Take this block's parameter snapshot (host automation, UI and presets all land here)
+    syncProcessorsForBlock();
+
     // Clear output channels that didn't contain input data
     for (auto i = totalNumInputChannels; i < totalNumOutputChannels; ++i)
         buffer.clear(i, 0, buffer.getNumSamples());
 
-    // Calculate input levels for the meters
-    float newLevelLeft = 0.0f;
-    float newLevelRight = 0.0f;
-    if (totalNumInputChannels > 0)
-        newLevelLeft = buffer.getRMSLevel(0, 0, buffer.getNumSamples());
-    if (totalNumInputChannels > 1)
-        newLevelRight = buffer.getRMSLevel(1, 0, buffer.getNumSamples());
-    levelLeft.setTargetValue(newLevelLeft);
-    levelRight.setTargetValue(newLevelRight);
-    levelLeft.skip(buffer.getNumSamples());
-    levelRight.skip(buffer.getNumSamples());
-
-    // Get the current BPM from the host
+    // Meter the input before any processing
+    inputMeter.processBlock(buffer);
+
+    // Get the current tempo and song position from the host
     double currentBpm = 120.0; // Default value
+    PulseTransport transport;
+
     if (auto *playHead = getPlayHead())
     {
-        juce::AudioPlayHead::CurrentPositionInfo positionInfo;
-        if (playHead->getCurrentPosition(positionInfo))
+        if (const auto position = playHead->getPosition())
         {
-            currentBpm = positionInfo.bpm;
+            if (const auto bpm = position->getBpm())
+                currentBpm = *bpm;
+
+            transport.isPlaying = position->getIsPlaying();
+
+            if (const auto ppq = position->getPpqPosition())
+            {
+                transport.hasPosition = true;
+                transport.ppqPosition = *ppq;
+            }
+
+            if (const auto loop = position->getLoopPoints())
+            {
+                transport.isLooping = position->getIsLooping();
+                transport.loopStartPpq = loop->ppqStart;
+                transport.loopEndPpq = loop->ppqEnd;
+            }
         }
     }
 
-    // Update pulse processor BPM
+    pulseProcessor.setTransport(transport);
+
+    // Tempo-synced stages follow the host BPM
     pulseProcessor.setBpm(currentBpm);
+    delayProcessor.setBpm(currentBpm);
 
     // Process audio through signal chain
     delayProcessor.processBlock(buffer);      // First delay
-    distortionProcessor.processBlock(buffer); // Then distortion
-    filterProcessor.processBlock(buffer);     // Then filter
-    pulseProcessor.processBlock(buffer);      // Finally pulse effect
-
-    // Calculate output levels after all processing
-    float newOutputLevelLeft = 0.0f;
-    float newOutputLevelRight = 0.0f;
-    if (totalNumOutputChannels > 0)
-        newOutputLevelLeft = buffer.getRMSLevel(0, 0, buffer.getNumSamples());
-    if (totalNumOutputChannels > 1)
-        newOutputLevelRight = buffer.getRMSLevel(1, 0, buffer.getNumSamples());
-    outputLevelLeft.setTargetValue(newOutputLevelLeft);
-    outputLevelRight.setTargetValue(newOutputLevelRight);
-    outputLevelLeft.skip(buffer.getNumSamples());
-    outputLevelRight.skip(buffer.getNumSamples());
-
-    // Store post-processed buffer for oscilloscope
-    {
-        juce::ScopedLock lock(outputBufferLock);
-        outputBuffer.makeCopyOf(buffer);
-    }
+    distortionProcessor.processBlock(buffer, scratchArena); // Then distortion
+    filterProcessor.processBlock(buffer);                   // Then filter
+    pulseProcessor.processBlock(buffer);                    // Finally pulse effect
+
+    // Dip the output around a preset swap
+    swapFade.process(buffer);
+
+    // Meter the output after all processing
+    outputMeter.processBlock(buffer);
+
+    // Hand the post-processed signal to the oscilloscope
+    scopeFifo.push(buffer);
 }
 
 bool OxideAudioProcessor::hasEditor() const
@@ -193,186 +460,76 @@ juce::AudioProcessorEditor *OxideAudioProcessor::createEditor()
 
 void OxideAudioProcessor::getStateInformation(juce::MemoryBlock &destData)
 {
-    // Store plugin state (parameters)
-    juce::MemoryOutputStream stream(destData, true);
-
-    // Store distortion parameters
-    stream.writeFloat(distortionProcessor.getDrive());
-    stream.writeFloat(distortionProcessor.getMix());
-    stream.writeFloat(distortionProcessor.getInputGain());
-    stream.writeFloat(distortionProcessor.getOutputGain());
-
-    // Store the distortion algorithm as an integer value
-    int algorithmValue = static_cast<int>(distortionProcessor.getAlgorithm());
-    stream.writeInt(algorithmValue);
+    // Store the whole parameter tree as XML
+    auto state = parameters.copyState();
+    std::unique_ptr<juce::XmlElement> xml(state.createXml());
+    copyXmlToBinary(*xml, destData);
+}
 
-    // Store delay parameters
-    stream.writeFloat(delayProcessor.getDelayTime());
-    stream.writeFloat(delayProcessor.getFeedback());
-    stream.writeFloat(delayProcessor.getMix());
-    stream.writeInt(delayProcessor.getPingPong() ? 1 : 0);
+void OxideAudioProcessor::setStateInformation(const void *data, int sizeInBytes)
+{
+    std::unique_ptr<juce::XmlElement> xmlState(getXmlFromBinary(data, sizeInBytes));
 
-    // Store filter parameters
-    stream.writeFloat(filterProcessor.getFrequency());
-    stream.writeFloat(filterProcessor.getResonance());
-    stream.writeInt(static_cast<int>(filterProcessor.getFilterType()));
+    if (xmlState != nullptr && xmlState->hasTagName(parameters.state.getType()))
+    {
+        // Session recall replaces every parameter, so it is swapped in like a preset
+        beginStateWrite();
+        parameters.replaceState(juce::ValueTree::fromXml(*xmlState));
+        endStateWrite();
+        return;
+    }
 
-    // Store pulse parameters
-    stream.writeFloat(pulseProcessor.getMix());
-    stream.writeInt(static_cast<int>(pulseProcessor.getRate()));
+    // Sessions saved before the parameter store used a raw binary stream; they replace
+    // the same parameters, so they are swapped in the same way
+    beginStateWrite();
+    setLegacyStateInformation(data, sizeInBytes);
+    endStateWrite();
 }
 
-void OxideAudioProcessor::setStateInformation(const void *data, int sizeInBytes)
+void OxideAudioProcessor::setLegacyStateInformation(const void *data, int sizeInBytes)
 {
-    // Restore plugin state (parameters)
     juce::MemoryInputStream stream(data, static_cast<size_t>(sizeInBytes), false);
 
     // Check how much data we have available
-    const int bytesAvailable = stream.getNumBytesRemaining();
+    const auto bytesAvailable = static_cast<size_t>(stream.getNumBytesRemaining());
 
-    if (bytesAvailable >= sizeof(float) * 4 + sizeof(int) + sizeof(float) * 4 + sizeof(int) * 3 + sizeof(float))
-    {
-        // Full state with all processor parameters including pulse
-
-        // Distortion parameters
-        float drive = stream.readFloat();
-        float mix = stream.readFloat();
-        float inputGain = stream.readFloat();
-        float outputGain = stream.readFloat();
-        int algorithmValue = stream.readInt();
-
-        // Delay parameters
-        float delayTime = stream.readFloat();
-        float feedback = stream.readFloat();
-        float delayMix = stream.readFloat();
-        bool pingPong = stream.readInt() > 0;
-
-        // Filter parameters
-        float filterFreq = stream.readFloat();
-        float resonance = stream.readFloat();
-        int filterTypeValue = stream.readInt();
-
-        // Pulse parameters
-        float pulseMix = stream.readFloat();
-
-        // Apply distortion parameters
-        distortionProcessor.setDrive(drive);
-        distortionProcessor.setMix(mix);
-        distortionProcessor.setInputGain(inputGain);
-        distortionProcessor.setOutputGain(outputGain);
-        distortionProcessor.setAlgorithm("soft_clip");
-
-        // Apply delay parameters
-        delayProcessor.setDelayTime(delayTime);
-        delayProcessor.setFeedback(feedback);
-        delayProcessor.setMix(delayMix);
-        delayProcessor.setPingPong(pingPong);
-
-        // Apply filter parameters
-        filterProcessor.setFrequency(filterFreq);
-        filterProcessor.setResonance(resonance);
-        filterProcessor.setFilterType(static_cast<FilterType>(filterTypeValue));
-
-        // Apply pulse parameters
-        pulseProcessor.setMix(pulseMix);
-    }
-    else if (bytesAvailable >= sizeof(float) * 4 + sizeof(int) + sizeof(float) * 4 + sizeof(int) * 3)
-    {
-        // Full state with all processor parameters but no pulse
-
-        // Distortion parameters
-        float drive = stream.readFloat();
-        float mix = stream.readFloat();
-        float inputGain = stream.readFloat();
-        float outputGain = stream.readFloat();
-        int algorithmValue = stream.readInt();
-
-        // Delay parameters
-        float delayTime = stream.readFloat();
-        float feedback = stream.readFloat();
-        float delayMix = stream.readFloat();
-        bool pingPong = stream.readInt() > 0;
-
-        // Filter parameters
-        float filterFreq = stream.readFloat();
-        float resonance = stream.readFloat();
-        int filterTypeValue = stream.readInt();
-
-        // Apply distortion parameters
-        distortionProcessor.setDrive(drive);
-        distortionProcessor.setMix(mix);
-        distortionProcessor.setInputGain(inputGain);
-        distortionProcessor.setOutputGain(outputGain);
-        distortionProcessor.setAlgorithm("soft_clip");
-
-        // Apply delay parameters
-        delayProcessor.setDelayTime(delayTime);
-        delayProcessor.setFeedback(feedback);
-        delayProcessor.setMix(delayMix);
-        delayProcessor.setPingPong(pingPong);
-
-        // Apply filter parameters
-        filterProcessor.setFrequency(filterFreq);
-        filterProcessor.setResonance(resonance);
-        filterProcessor.setFilterType(static_cast<FilterType>(filterTypeValue));
-
-        // Use default for pulse
-        pulseProcessor.setMix(0.0f);
-    }
-    else if (bytesAvailable >= sizeof(float) * 4 + sizeof(int))
-    {
-        // State with just distortion parameters (backward compatibility)
-        float drive = stream.readFloat();
-        float mix = stream.readFloat();
-        float inputGain = stream.readFloat();
-        float outputGain = stream.readFloat();
-        int algorithmValue = stream.readInt();
-
-        distortionProcessor.setDrive(drive);
-        distortionProcessor.setMix(mix);
-        distortionProcessor.setInputGain(inputGain);
-        distortionProcessor.setOutputGain(outputGain);
-        distortionProcessor.setAlgorithm("soft_clip");
-
-        // Use default values for delay and filter
-        // Use default for pulse
-        pulseProcessor.setMix(0.0f);
-    }
-    else if (bytesAvailable >= sizeof(float) * 4)
-    {
-        // State without algorithm (backward compatibility)
-        float drive = stream.readFloat();
-        float mix = stream.readFloat();
-        float inputGain = stream.readFloat();
-        float outputGain = stream.readFloat();
-
-        distortionProcessor.setDrive(drive);
-        distortionProcessor.setMix(mix);
-        distortionProcessor.setInputGain(inputGain);
-        distortionProcessor.setOutputGain(outputGain);
-        // Use default algorithm
-        distortionProcessor.setAlgorithm("soft_clip");
-
-        // Use default values for delay and filter
-        // Use default for pulse
-        pulseProcessor.setMix(0.0f);
-    }
-    else if (bytesAvailable >= sizeof(float) * 2)
+    // Even the oldest version stored drive and mix
+    if (bytesAvailable < sizeof(float) * 2)
+        return;
+
+    setParameterValue(ParameterIDs::drive, stream.readFloat());
+    setParameterValue(ParameterIDs::mix, stream.readFloat());
+
+    // Input and output gain came next
+    const bool hasGains = bytesAvailable >= sizeof(float) * 4;
+    setParameterValue(ParameterIDs::inputGain, hasGains ? stream.readFloat() : 0.0f);
+    setParameterValue(ParameterIDs::outputGain, hasGains ? stream.readFloat() : 0.0f);
+
+    // Then the distortion algorithm
+    if (bytesAvailable >= sizeof(float) * 4 + sizeof(int))
+        setParameterValue(ParameterIDs::algorithm, static_cast<float>(juce::jlimit(0, 4, stream.readInt())));
+
+    // Full state with delay and filter parameters
+    if (bytesAvailable >= sizeof(float) * 4 + sizeof(int) + sizeof(float) * 4 + sizeof(int) * 3)
     {
-        // Even older version with just drive and mix
-        float drive = stream.readFloat();
-        float mix = stream.readFloat();
-
-        distortionProcessor.setDrive(drive);
-        distortionProcessor.setMix(mix);
-        distortionProcessor.setInputGain(0.0f);
-        distortionProcessor.setOutputGain(0.0f);
-        distortionProcessor.setAlgorithm("soft_clip");
-
-        // Use default values for delay and filter
-        // Use default for pulse
-        pulseProcessor.setMix(0.0f);
+        setParameterValue(ParameterIDs::delayTime, stream.readFloat());
+        setParameterValue(ParameterIDs::delayFeedback, stream.readFloat());
+        setParameterValue(ParameterIDs::delayMix, stream.readFloat());
+        setParameterValue(ParameterIDs::pingPong, stream.readInt() > 0 ? 1.0f : 0.0f);
+
+        setParameterValue(ParameterIDs::filterFrequency, stream.readFloat());
+        setParameterValue(ParameterIDs::filterResonance, stream.readFloat());
+        setParameterValue(ParameterIDs::filterType, static_cast<float>(juce::jlimit(0, 2, stream.readInt())));
     }
+
+    // Pulse mix, falling back to no effect for older states
+    const bool hasPulse = bytesAvailable >= sizeof(float) * 4 + sizeof(int) + sizeof(float) * 4 + sizeof(int) * 3 + sizeof(float);
+    setParameterValue(ParameterIDs::pulseMix, hasPulse ? stream.readFloat() : 0.0f);
+
+    // Pulse rate followed the pulse mix and was the last field the binary format wrote
+    if (hasPulse && stream.getNumBytesRemaining() >= static_cast<juce::int64>(sizeof(int)))
+        setParameterValue(ParameterIDs::pulseRate,
+                          static_cast<float>(juce::jlimit(0, PulseProcessor::getRateNames().size() - 1, stream.readInt())));
 }
 
 juce::AudioProcessor *JUCE_CALLTYPE createPluginFilter()
@@ -5,10 +5,18 @@
 #include "dsp/delay/DelayProcessor.h"
 #include "dsp/filter/FilterProcessor.h"
 #include "dsp/pulse/PulseProcessor.h"
+#include "dsp/meter/MeterProcessor.h"
+#include "dsp/common/ScratchArena.h"
+#include "dsp/common/ScopeFifo.h"
+#include "dsp/common/SwapFade.h"
+#include "ParameterIDs.h"
+#include "PresetState.h"
 
 class PresetManager;
 
-class OxideAudioProcessor : public juce::AudioProcessor
+class OxideAudioProcessor : public juce::AudioProcessor,
+                            private juce::AudioProcessorValueTreeState::Listener,
+                            private juce::AsyncUpdater
 {
 public:
     OxideAudioProcessor();
@@ -46,16 +54,29 @@ public:
     PulseProcessor &getPulseProcessor() { return pulseProcessor; }
     PresetManager *getPresetManager(); // might return nullptr if not initialized yet
 
-    float getLeftLevel() const { return levelLeft.getCurrentValue(); }
-    float getRightLevel() const { return levelRight.getCurrentValue(); }
-    float getOutputLeftLevel() const { return outputLevelLeft.getCurrentValue(); }
-    float getOutputRightLevel() const { return outputLevelRight.getCurrentValue(); }
+    // Parameter store shared by the host, the UI and presets
+    juce::AudioProcessorValueTreeState &getParameters() { return parameters; }
 
-    juce::AudioBuffer<float> getOutputBuffer()
-    {
-        juce::ScopedLock lock(outputBufferLock);
-        return outputBuffer;
-    }
+    // Sets a parameter from its plain value (choice parameters take an index) and notifies the host.
+    // Safe to call from the message thread; the audio thread picks it up on the next block.
+    void setParameterValue(const juce::String &parameterId, float plainValue);
+
+    // Writes a whole preset to the parameter store and notifies the host. The audio thread
+    // fades out, swaps every setting in at one block boundary and fades back in, so it
+    // never plays half a preset. Message thread only; never blocks on the audio thread.
+    void applyPresetState(const PresetState &state);
+
+    // Input meter runs before the stages, output meter after them
+    MeterProcessor &getInputMeter() { return inputMeter; }
+    MeterProcessor &getOutputMeter() { return outputMeter; }
+
+    // Post-processing signal for the oscilloscope, drained by the editor
+    ScopeFifo &getScopeFifo() { return scopeFifo; }
+
+    // Whether the editor opens natively drawn instead of as the web page. Saved with the
+    // session, so each instance reopens the way it was left. Message thread only.
+    bool getUseNativeEditor() const;
+    void setUseNativeEditor(bool shouldUseNativeEditor);
 
 private:
     DelayProcessor delayProcessor;
@@ -63,15 +84,102 @@ private:
     FilterProcessor filterProcessor;
     PulseProcessor pulseProcessor;
 
+    // Preallocated dry-signal memory shared by the stages
+    ScratchArena scratchArena;
+
+    // Host-visible parameters, read by the audio thread once per block
+    juce::AudioProcessorValueTreeState parameters;
+
+    struct ParameterPointers
+    {
+        std::atomic<float> *drive = nullptr;
+        std::atomic<float> *mix = nullptr;
+        std::atomic<float> *inputGain = nullptr;
+        std::atomic<float> *outputGain = nullptr;
+        std::atomic<float> *algorithm = nullptr;
+        std::atomic<float> *oversampling = nullptr;
+        std::atomic<float> *delayTime = nullptr;
+        std::atomic<float> *delayFeedback = nullptr;
+        std::atomic<float> *delayMix = nullptr;
+        std::atomic<float> *pingPong = nullptr;
+        std::atomic<float> *delaySync = nullptr;
+        std::atomic<float> *delayNote = nullptr;
+        std::atomic<float> *filterType = nullptr;
+        std::atomic<float> *filterFrequency = nullptr;
+        std::atomic<float> *filterResonance = nullptr;
+        std::atomic<float> *pulseMix = nullptr;
+        std::atomic<float> *pulseRate = nullptr;
+    } parameterPointers;
+
+    // One consistent read of the parameters above, taken by the audio thread
+    struct ParameterSnapshot
+    {
+        float drive = 0.0f;
+        float mix = 0.0f;
+        float inputGain = 0.0f;
+        float outputGain = 0.0f;
+        float algorithm = 0.0f;
+        float oversampling = 0.0f;
+        float delayTime = 0.0f;
+        float delayFeedback = 0.0f;
+        float delayMix = 0.0f;
+        float pingPong = 0.0f;
+        float delaySync = 0.0f;
+        float delayNote = 0.0f;
+        float filterType = 0.0f;
+        float filterFrequency = 0.0f;
+        float filterResonance = 0.0f;
+        float pulseMix = 0.0f;
+        float pulseRate = 0.0f;
+    };
+
+    // Made odd before a whole-state write to the parameter store and even again after it,
+    // so the audio thread can tell a consistent snapshot from a torn one
+    std::atomic<juce::uint32> stateWriteSequence{0};
+
+    // Last whole-state write the audio thread swapped in; audio thread only
+    juce::uint32 appliedStateSequence = 0;
+
+    // Oversampling factor the distortion stage was last given. Changing it restarts the
+    // stage's filters, so a new factor is swapped in behind the fade too
+    int appliedOversampling = 0;
+
+    // Dips the output around a whole-state swap
+    SwapFade swapFade;
+
+    // Set between prepareToPlay and releaseResources
+    std::atomic<bool> audioPrepared{false};
+
+    static juce::AudioProcessorValueTreeState::ParameterLayout createParameterLayout();
+
+    // Pushes one snapshot of the parameter store into the DSP stages
+    void syncProcessorsWithParameters();
+    ParameterSnapshot readParameterSnapshot() const;
+    void applyParameterSnapshot(const ParameterSnapshot &snapshot);
+
+    // Audio thread: takes this block's parameter snapshot, swapping whole states in
+    // behind the fade
+    void syncProcessorsForBlock();
+
+    // Bracket writes that replace the whole state, such as presets and session recall
+    void beginStateWrite();
+    void endStateWrite();
+
+    // Oversampling changes latency, which is reported to the host from the message thread
+    void parameterChanged(const juce::String &parameterId, float newValue) override;
+    void handleAsyncUpdate() override;
+
+    // Reads the binary state format used before the parameter store existed
+    void setLegacyStateInformation(const void *data, int sizeInBytes);
+
     std::unique_ptr<PresetManager> presetManager;
     bool presetManagerInitialized = false;
 
-    juce::LinearSmoothedValue<float> levelLeft, levelRight;
-    juce::LinearSmoothedValue<float> outputLevelLeft, outputLevelRight;
+    MeterProcessor inputMeter;
+    MeterProcessor outputMeter;
 
-    // Buffer for oscilloscope
-    juce::AudioBuffer<float> outputBuffer;
-    juce::CriticalSection outputBufferLock;
+    // Samples for oscilloscope
+    ScopeFifo scopeFifo;
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(OxideAudioProcessor)
 };
\ No newline at end of file
@@ -0,0 +1,161 @@
+#include "PresetIndex.h"
+
+PresetIndex::PresetIndex()
+    : juce::Thread("Oxide preset index")
+{
+}
+
+PresetIndex::~PresetIndex()
+{
+    stopThread(2000);
+}
+
+void PresetIndex::watch(const juce::File &directoryToWatch)
+{
+    if (isThreadRunning())
+        return;
+
+    {
+        const juce::ScopedLock scopedLock(lock);
+        directory = directoryToWatch;
+    }
+
+    startThread(juce::Thread::Priority::background);
+}
+
+juce::StringArray PresetIndex::getNames() const
+{
+    const juce::ScopedLock scopedLock(lock);
+    return sortedNames;
+}
+
+std::optional<PresetIndex::Entry> PresetIndex::find(const juce::String &name) const
+{
+    const juce::ScopedLock scopedLock(lock);
+
+    const auto entry = entries.find(normalise(name));
+    if (entry == entries.end())
+        return std::nullopt;
+
+    return entry->second;
+}
+
+void PresetIndex::update(const juce::File &file)
+{
+    const auto entry = readEntry(file);
+    if (!entry.has_value())
+        return;
+
+    {
+        const juce::ScopedLock scopedLock(lock);
+        entries[normalise(entry->name)] = *entry;
+        updateSortedNames();
+    }
+
+    sendChangeMessage();
+}
+
+juce::String PresetIndex::normalise(const juce::String &name)
+{
+    return name.trim().replaceCharacter('_', ' ').toLowerCase();
+}
+
+void PresetIndex::run()
+{
+    while (!threadShouldExit())
+    {
+        rescan();
+
+        // Listeners hear about the first scan even when the directory is empty
+        if (!ready.exchange(true))
+            sendChangeMessage();
+
+        wait(pollIntervalMs);
+    }
+}
+
+void PresetIndex::rescan()
+{
+    juce::File directoryToScan;
+
+    {
+        const juce::ScopedLock scopedLock(lock);
+        directoryToScan = directory;
+    }
+
+    const auto files = directoryToScan.findChildFiles(juce::File::findFiles, false, "*.xml");
+
+    std::unordered_map<juce::String, Entry> next;
+    next.reserve(static_cast<size_t>(files.size()));
+    bool changed = false;
+
+    for (const auto &file : files)
+    {
+        if (threadShouldExit())
+            return;
+
+        const auto key = normalise(file.getFileNameWithoutExtension());
+        const auto modified = file.getLastModificationTime();
+        const auto size = file.getSize();
+
+        // Unchanged files keep their entry without being opened
+        const auto existing = scannedEntries.find(key);
+        if (existing != scannedEntries.end() && existing->second.file == file &&
+            existing->second.modified == modified && existing->second.size == size)
+        {
+            next.emplace(key, existing->second);
+            continue;
+        }
+
+        if (auto entry = readEntry(file))
+        {
+            next[key] = std::move(*entry);
+            changed = true;
+        }
+    }
+
+    // Anything left out of the new map was deleted or renamed
+    changed = changed || next.size() != scannedEntries.size();
+    if (!changed)
+        return;
+
+    // The copy is made outside the lock; readers only wait for the swap
+    scannedEntries.swap(next);
+    auto published = scannedEntries;
+
+    {
+        const juce::ScopedLock scopedLock(lock);
+        entries.swap(published);
+        updateSortedNames();
+    }
+
+    sendChangeMessage();
+}
+
+void PresetIndex::updateSortedNames()
+{
+    sortedNames.clearQuick();
+    sortedNames.ensureStorageAllocated(static_cast<int>(entries.size()));
+
+    for (const auto &entry : entries)
+        sortedNames.add(entry.second.name);
+
+    sortedNames.sortNatural();
+}
+
+std::optional<PresetIndex::Entry> PresetIndex::readEntry(const juce::File &file)
+{
+    // Only the root element is parsed; the parameters are read when the preset is loaded
+    juce::XmlDocument document(file);
+    const auto root = document.getDocumentElement(true);
+    if (root == nullptr || !root->hasTagName("OxidePreset"))
+        return std::nullopt;
+
+    Entry entry;
+    entry.name = file.getFileNameWithoutExtension();
+    entry.file = file;
+    entry.modified = file.getLastModificationTime();
+    entry.size = file.getSize();
+    entry.version = root->getStringAttribute("version", "1.0");
+    return entry;
+}
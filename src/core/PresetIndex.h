@@ -0,0 +1,76 @@
+#pragma once
+
+#include <JuceHeader.h>
+#include <optional>
+#include <unordered_map>
+
+// In-memory index of the user preset directory, shared by every plugin instance in the
+// process (hold it through a juce::SharedResourcePointer).
+//
+// A background thread builds the index once, then polls the directory and re-reads only
+// files whose size or modification time changed, so listing presets and looking one up
+// never touch the disk. Listeners are notified on the message thread whenever the set of
+// presets changes.
+class PresetIndex : public juce::ChangeBroadcaster,
+                    private juce::Thread
+{
+public:
+    struct Entry
+    {
+        juce::String name; // Display name, from the file name
+        juce::File file;
+        juce::Time modified;
+        juce::int64 size = 0;
+        juce::String version; // From the preset's own root element
+    };
+
+    PresetIndex();
+    ~PresetIndex() override;
+
+    // Starts indexing the directory. Only the first call has an effect, since every
+    // instance shares the same preset directory.
+    void watch(const juce::File &directory);
+
+    // Whether the first scan has finished
+    bool isReady() const { return ready.load(); }
+
+    // Display names, sorted
+    juce::StringArray getNames() const;
+
+    // Looks a preset up by name, ignoring case and treating "_" and " " alike
+    std::optional<Entry> find(const juce::String &name) const;
+
+    // Records a preset file the caller has just written, without waiting for the next poll
+    void update(const juce::File &file);
+
+    // The key presets are indexed under
+    static juce::String normalise(const juce::String &name);
+
+private:
+    // How often the directory is checked for changes
+    static constexpr int pollIntervalMs = 2000;
+
+    void run() override;
+
+    // Brings the index in line with the directory; publishes and notifies listeners only
+    // if a file was added, removed or changed size or modification time
+    void rescan();
+
+    // Rebuilds sortedNames from entries; caller holds the lock
+    void updateSortedNames();
+
+    // Reads a preset's metadata (root element only); empty if it is not an Oxide preset
+    static std::optional<Entry> readEntry(const juce::File &file);
+
+    mutable juce::CriticalSection lock;
+    juce::File directory;
+    std::unordered_map<juce::String, Entry> entries;
+    juce::StringArray sortedNames;
+    std::atomic<bool> ready{false};
+
+    // What the last scan found; the polling thread compares against this without taking
+    // the lock, and only copies it into entries when something changed
+    std::unordered_map<juce::String, Entry> scannedEntries;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(PresetIndex)
+};
@@ -1,30 +1,58 @@
 #include "PresetManager.h"
 #include "PluginProcessor.h"
+#include "BinaryData.h"
 
-PresetManager::PresetManager(OxideAudioProcessor &processor)
-    : processorRef(processor), isInitialized(false)
+struct PresetManager::FactoryBank
 {
-    // Get the presets directory
-    presetsDirectory = getUserPresetsDirectory();
+    FactoryBank()
+        : bank(juce::parseXMLIfTagMatches(juce::String::createStringFromData(BinaryData::factory_presets_xml,
+                                                                              BinaryData::factory_presets_xmlSize),
+                                          "OxidePresetBank"))
+    {
+        jassert(bank != nullptr);
+
+        if (bank == nullptr)
+            return;
 
-    // Create the directory if it doesn't exist
-    if (!presetsDirectory.exists())
+        for (auto *preset : bank->getChildWithTagNameIterator("OxidePreset"))
+        {
+            const auto name = preset->getStringAttribute("name");
+            names.add(name);
+            presets.emplace(PresetIndex::normalise(name), preset);
+        }
+    }
+
+    const juce::XmlElement *find(const juce::String &name) const
     {
-        presetsDirectory.createDirectory();
+        const auto preset = presets.find(PresetIndex::normalise(name));
+        return preset != presets.end() ? preset->second : nullptr;
     }
 
+    std::unique_ptr<juce::XmlElement> bank;
+    juce::StringArray names; // In bank order
+    std::unordered_map<juce::String, const juce::XmlElement *> presets;
+};
+
+struct PresetManager::LoaderPool : juce::ThreadPool
+{
+    LoaderPool() : juce::ThreadPool(1, 0, juce::Thread::Priority::low) {}
+};
+
+PresetManager::PresetManager(OxideAudioProcessor &processor)
+    : processorRef(processor), isInitialized(false)
+{
+    // Get the presets directory; it is only created once the user saves a preset
+    presetsDirectory = getUserPresetsDirectory();
+
     isInitialized = true;
 
-    // Create default presets if none exist
-    if (presetsDirectory.getNumberOfChildFiles(juce::File::findFiles) == 0)
-    {
-        createDefaultPresetsIfNeeded();
-    }
+    presetIndex->addChangeListener(this);
+    presetIndex->watch(presetsDirectory);
 }
 
 PresetManager::~PresetManager()
 {
-    // Nothing to clean up
+    presetIndex->removeChangeListener(this);
 }
 
 void PresetManager::savePreset(const juce::String &presetName)
@@ -43,8 +71,10 @@ void PresetManager::savePreset(const juce::String &presetName)
     saveProcessorStateToXml(xml.get());
 
     // Save to file
+    presetsDirectory.createDirectory();
     juce::File presetFile = presetsDirectory.getChildFile(presetName + ".xml");
-    xml->writeToFile(presetFile, "");
+    if (xml->writeToFile(presetFile, ""))
+        presetIndex->update(presetFile);
 }
 
 bool PresetManager::loadPreset(const juce::String &presetName)
@@ -54,73 +84,68 @@ bool PresetManager::loadPreset(const juce::String &presetName)
         return false;
     }
 
-    // Find the preset file
-    juce::File presetFile = presetsDirectory.getChildFile(presetName + ".xml");
+    // Look the preset up by name; until the first scan finishes, try the file directly
+    juce::String fileName = presetName.endsWith(".xml") ? presetName.dropLastCharacters(4) : presetName;
+    juce::String displayName = fileName;
+    juce::File presetFile;
 
-    if (!presetFile.existsAsFile())
+    const auto entry = presetIndex->find(fileName);
+    if (entry.has_value())
     {
-        // Try with .xml extension if user included it
-        if (presetName.endsWith(".xml"))
-        {
-            presetFile = presetsDirectory.getChildFile(presetName);
-        }
-
-        // Try with underscore instead of spaces
-        if (!presetFile.existsAsFile() && presetName.contains("_"))
-        {
-            juce::String spacedName = presetName.replaceCharacters("_", " ");
-            presetFile = presetsDirectory.getChildFile(spacedName + ".xml");
-
-            // If still not found, try case-insensitive search
-            if (!presetFile.existsAsFile())
-            {
-                // Get all XML files
-                juce::Array<juce::File> allXmlFiles = presetsDirectory.findChildFiles(
-                    juce::File::findFiles, false, "*.xml");
-
-                // Look for a case-insensitive match
-                for (const auto &file : allXmlFiles)
-                {
-                    if (file.getFileNameWithoutExtension().toLowerCase() == spacedName.toLowerCase())
-                    {
-                        presetFile = file;
-                        break;
-                    }
-                }
-            }
-        }
-
-        if (!presetFile.existsAsFile())
-        {
-            // As a last resort, try direct case-insensitive search
-            juce::Array<juce::File> allXmlFiles = presetsDirectory.findChildFiles(
-                juce::File::findFiles, false, "*.xml");
-
-            for (const auto &file : allXmlFiles)
-            {
-                if (file.getFileNameWithoutExtension().toLowerCase() == presetName.toLowerCase())
-                {
-                    presetFile = file;
-                    break;
-                }
-            }
-        }
-
-        if (!presetFile.existsAsFile())
-        {
-            return false;
-        }
+        presetFile = entry->file;
+        displayName = entry->name;
     }
+    else if (!presetIndex->isReady())
+    {
+        presetFile = presetsDirectory.getChildFile(fileName + ".xml");
+    }
+
+    // User presets shadow factory presets of the same name
+    const juce::XmlElement *factoryXml = factoryBank->find(fileName);
+    if (factoryXml != nullptr && !entry.has_value())
+        displayName = factoryXml->getStringAttribute("name", fileName);
 
-    // Parse the XML file
-    std::unique_ptr<juce::XmlElement> xml = juce::XmlDocument::parse(presetFile);
-    if (xml == nullptr || xml->getTagName() != "OxidePreset")
+    if (presetFile == juce::File() && factoryXml == nullptr)
     {
         return false;
     }
 
-    // Load processor state
-    loadProcessorStateFromXml(xml.get());
+    // Values the preset leaves out stay as they are
+    PresetState state = getCurrentState();
+    state.name = displayName;
+
+    const auto generation = ++loadGeneration;
+
+    // The job holds on to the factory bank, which may otherwise go with the last instance
+    loaderPool->addJob([manager = juce::WeakReference<PresetManager>(this), generation, presetFile,
+                        factoryXml, bank = factoryBank, state = std::move(state)]() mutable
+                       {
+                           std::unique_ptr<juce::XmlElement> userXml;
+                           const juce::XmlElement *xml = factoryXml;
+
+                           // A user preset that fails to parse falls back to the factory
+                           // preset of the same name, if there is one
+                           if (presetFile.existsAsFile())
+                           {
+                               userXml = juce::XmlDocument::parse(presetFile);
+                               if (userXml != nullptr && userXml->hasTagName("OxidePreset"))
+                                   xml = userXml.get();
+                           }
+
+                           if (xml == nullptr)
+                               return;
+
+                           juce::MessageManager::callAsync([manager, generation,
+                                                            loaded = parsePresetState(*xml, std::move(state))]()
+                                                           {
+                                                               if (manager == nullptr || manager->loadGeneration != generation)
+                                                                   return;
+
+                                                               manager->processorRef.applyPresetState(loaded);
+
+                                                               if (manager->onPresetLoaded)
+                                                                   manager->onPresetLoaded(loaded.name);
+                                                           }); });
 
     return true;
 }
@@ -136,14 +161,13 @@ juce::StringArray PresetManager::getPresetList()
         return presetList;
     }
 
-    // Find all XML files in the presets directory
-    juce::Array<juce::File> presetFiles = presetsDirectory.findChildFiles(
-        juce::File::findFiles, false, "*.xml");
+    presetList = factoryBank->names;
 
-    // Add each preset name to the list
-    for (const auto &file : presetFiles)
+    // User presets that shadow a factory preset already have their entry
+    for (const auto &name : presetIndex->getNames())
     {
-        presetList.add(file.getFileNameWithoutExtension());
+        if (factoryBank->find(name) == nullptr)
+            presetList.add(name);
     }
 
     // Add a default preset if none found
@@ -155,6 +179,12 @@ juce::StringArray PresetManager::getPresetList()
     return presetList;
 }
 
+void PresetManager::changeListenerCallback(juce::ChangeBroadcaster *)
+{
+    if (onPresetListChanged)
+        onPresetListChanged();
+}
+
 juce::File PresetManager::getUserPresetsDirectory() const
 {
     juce::File dir;
@@ -183,10 +213,17 @@ juce::File PresetManager::getUserPresetsDirectory() const
 
 void PresetManager::saveProcessorStateToXml(juce::XmlElement *xml)
 {
-    auto &distortion = processorRef.getDistortionProcessor();
-    auto &delay = processorRef.getDelayProcessor();
-    auto &filter = processorRef.getFilterProcessor();
-    auto &pulse = processorRef.getPulseProcessor();
+    // Read from the parameter store rather than the DSP stages, which only
+    // catch up with parameter changes while audio is running
+    auto &parameters = processorRef.getParameters();
+    auto value = [&parameters](const juce::String &parameterId)
+    {
+        return parameters.getRawParameterValue(parameterId)->load();
+    };
+    auto choice = [&value](const juce::String &parameterId, const juce::StringArray &names)
+    {
+        return names[juce::jlimit(0, names.size() - 1, juce::roundToInt(value(parameterId)))];
+    };
 
     // Create sections for each processor
     auto distortionXml = xml->createNewChildElement("Distortion");
@@ -195,198 +232,127 @@ void PresetManager::saveProcessorStateToXml(juce::XmlElement *xml)
     auto pulseXml = xml->createNewChildElement("Pulse");
 
     // Distortion parameters
-    distortionXml->setAttribute("drive", distortion.getDrive());
-    distortionXml->setAttribute("mix", distortion.getMix());
-    distortionXml->setAttribute("inputGain", distortion.getInputGain());
-    distortionXml->setAttribute("outputGain", distortion.getOutputGain());
-    distortionXml->setAttribute("algorithm", distortion.getAlgorithmName());
+    distortionXml->setAttribute("drive", value(ParameterIDs::drive));
+    distortionXml->setAttribute("mix", value(ParameterIDs::mix));
+    distortionXml->setAttribute("inputGain", value(ParameterIDs::inputGain));
+    distortionXml->setAttribute("outputGain", value(ParameterIDs::outputGain));
+    distortionXml->setAttribute("algorithm", choice(ParameterIDs::algorithm, DistortionProcessor::getAlgorithmNames()));
+    distortionXml->setAttribute("oversampling", choice(ParameterIDs::oversampling, DistortionProcessor::getOversamplingNames()));
 
     // Delay parameters
-    delayXml->setAttribute("time", delay.getDelayTime());
-    delayXml->setAttribute("feedback", delay.getFeedback());
-    delayXml->setAttribute("mix", delay.getMix());
-    delayXml->setAttribute("pingPong", delay.getPingPong());
+    delayXml->setAttribute("time", value(ParameterIDs::delayTime));
+    delayXml->setAttribute("feedback", value(ParameterIDs::delayFeedback));
+    delayXml->setAttribute("mix", value(ParameterIDs::delayMix));
+    delayXml->setAttribute("pingPong", value(ParameterIDs::pingPong) >= 0.5f);
+    delayXml->setAttribute("sync", value(ParameterIDs::delaySync) >= 0.5f);
+    delayXml->setAttribute("note", choice(ParameterIDs::delayNote, DelayProcessor::getNoteValueNames()));
 
     // Filter parameters
-    filterXml->setAttribute("type", filter.getFilterTypeName());
-    filterXml->setAttribute("frequency", filter.getFrequency());
-    filterXml->setAttribute("resonance", filter.getResonance());
+    filterXml->setAttribute("type", choice(ParameterIDs::filterType, FilterProcessor::getFilterTypeNames()));
+    filterXml->setAttribute("frequency", value(ParameterIDs::filterFrequency));
+    filterXml->setAttribute("resonance", value(ParameterIDs::filterResonance));
 
     // Pulse parameters
-    pulseXml->setAttribute("mix", pulse.getMix());
-    pulseXml->setAttribute("rate", pulse.getRateString());
+    pulseXml->setAttribute("mix", value(ParameterIDs::pulseMix));
+    pulseXml->setAttribute("rate", choice(ParameterIDs::pulseRate, PulseProcessor::getRateNames()));
 }
 
-void PresetManager::loadProcessorStateFromXml(const juce::XmlElement *xml)
+PresetState PresetManager::getCurrentState() const
 {
-    auto &distortion = processorRef.getDistortionProcessor();
-    auto &delay = processorRef.getDelayProcessor();
-    auto &filter = processorRef.getFilterProcessor();
-    auto &pulse = processorRef.getPulseProcessor();
+    auto &parameters = processorRef.getParameters();
+    PresetState state;
+
+    for (size_t i = 0; i < PresetState::numParameters; ++i)
+        state.values[i] = parameters.getRawParameterValue(ParameterIDs::bridgeOrder[i])->load();
+
+    return state;
+}
+
+PresetState PresetManager::parsePresetState(const juce::XmlElement &xml, PresetState state)
+{
+    // The processor writes the finished state to the parameter store in one go, so the
+    // host sees the change and the audio thread swaps it in at a block boundary
+    auto setParameter = [&state](const char *parameterId, float value)
+    {
+        state.set(parameterId, value);
+    };
+
+    // Choice parameters are stored by name in presets; unknown names keep the current value
+    auto setChoice = [&setParameter](const char *parameterId, const juce::StringArray &names, const juce::String &name)
+    {
+        const int index = names.indexOf(name);
+        if (index >= 0)
+            setParameter(parameterId, static_cast<float>(index));
+    };
 
     // Extract distortion parameters
-    if (auto *distortionXml = xml->getChildByName("Distortion"))
+    if (auto *distortionXml = xml.getChildByName("Distortion"))
     {
         if (distortionXml->hasAttribute("drive"))
-            distortion.setDrive(distortionXml->getDoubleAttribute("drive"));
+            setParameter(ParameterIDs::drive, (float)distortionXml->getDoubleAttribute("drive"));
 
         if (distortionXml->hasAttribute("mix"))
-            distortion.setMix(distortionXml->getDoubleAttribute("mix"));
+            setParameter(ParameterIDs::mix, (float)distortionXml->getDoubleAttribute("mix"));
 
         if (distortionXml->hasAttribute("inputGain"))
-            distortion.setInputGain(distortionXml->getDoubleAttribute("inputGain"));
+            setParameter(ParameterIDs::inputGain, (float)distortionXml->getDoubleAttribute("inputGain"));
 
         if (distortionXml->hasAttribute("outputGain"))
-            distortion.setOutputGain(distortionXml->getDoubleAttribute("outputGain"));
+            setParameter(ParameterIDs::outputGain, (float)distortionXml->getDoubleAttribute("outputGain"));
 
         if (distortionXml->hasAttribute("algorithm"))
-        {
-            // Explicitly call the string version
-            juce::String algoStr = distortionXml->getStringAttribute("algorithm");
-            distortion.setAlgorithm(algoStr);
-        }
+            setChoice(ParameterIDs::algorithm, DistortionProcessor::getAlgorithmNames(),
+                      distortionXml->getStringAttribute("algorithm"));
+
+        if (distortionXml->hasAttribute("oversampling"))
+            setChoice(ParameterIDs::oversampling, DistortionProcessor::getOversamplingNames(),
+                      distortionXml->getStringAttribute("oversampling"));
     }
 
     // Extract delay parameters
-    if (auto *delayXml = xml->getChildByName("Delay"))
+    if (auto *delayXml = xml.getChildByName("Delay"))
     {
         if (delayXml->hasAttribute("time"))
-            delay.setDelayTime(delayXml->getDoubleAttribute("time"));
+            setParameter(ParameterIDs::delayTime, (float)delayXml->getDoubleAttribute("time"));
 
         if (delayXml->hasAttribute("feedback"))
-            delay.setFeedback(delayXml->getDoubleAttribute("feedback"));
+            setParameter(ParameterIDs::delayFeedback, (float)delayXml->getDoubleAttribute("feedback"));
 
         if (delayXml->hasAttribute("mix"))
-            delay.setMix(delayXml->getDoubleAttribute("mix"));
+            setParameter(ParameterIDs::delayMix, (float)delayXml->getDoubleAttribute("mix"));
 
         if (delayXml->hasAttribute("pingPong"))
-            delay.setPingPong(delayXml->getBoolAttribute("pingPong"));
+            setParameter(ParameterIDs::pingPong, delayXml->getBoolAttribute("pingPong") ? 1.0f : 0.0f);
+
+        // Presets saved before tempo sync existed are free running
+        setParameter(ParameterIDs::delaySync, delayXml->getBoolAttribute("sync", false) ? 1.0f : 0.0f);
+        setChoice(ParameterIDs::delayNote, DelayProcessor::getNoteValueNames(),
+                  delayXml->getStringAttribute("note", "1/4"));
     }
 
     // Extract filter parameters
-    if (auto *filterXml = xml->getChildByName("Filter"))
+    if (auto *filterXml = xml.getChildByName("Filter"))
     {
         if (filterXml->hasAttribute("type"))
-        {
-            // Explicitly call the string version
-            juce::String typeStr = filterXml->getStringAttribute("type");
-            filter.setFilterType(typeStr);
-        }
+            setChoice(ParameterIDs::filterType, FilterProcessor::getFilterTypeNames(),
+                      filterXml->getStringAttribute("type"));
 
         if (filterXml->hasAttribute("frequency"))
-            filter.setFrequency(filterXml->getDoubleAttribute("frequency"));
+            setParameter(ParameterIDs::filterFrequency, (float)filterXml->getDoubleAttribute("frequency"));
 
         if (filterXml->hasAttribute("resonance"))
-            filter.setResonance(filterXml->getDoubleAttribute("resonance"));
+            setParameter(ParameterIDs::filterResonance, (float)filterXml->getDoubleAttribute("resonance"));
     }
 
     // Extract pulse parameters
-    if (auto *pulseXml = xml->getChildByName("Pulse"))
+    if (auto *pulseXml = xml.getChildByName("Pulse"))
     {
         if (pulseXml->hasAttribute("mix"))
-            pulse.setMix(pulseXml->getDoubleAttribute("mix"));
+            setParameter(ParameterIDs::pulseMix, (float)pulseXml->getDoubleAttribute("mix"));
 
         if (pulseXml->hasAttribute("rate"))
-            pulse.setRate(pulseXml->getStringAttribute("rate"));
-    }
-}
-
-void PresetManager::createDefaultPresetsIfNeeded()
-{
-    // Don't create presets if we're not initialized
-    if (!isInitialized)
-    {
-        return;
-    }
-
-    // If there are already presets, don't create defaults
-    if (presetsDirectory.getNumberOfChildFiles(juce::File::findFiles) > 0)
-    {
-        return;
-    }
-
-    // Create a temporary XML to store the current state
-    auto currentState = std::make_unique<juce::XmlElement>("CurrentState");
-    saveProcessorStateToXml(currentState.get());
-
-    // Define the default presets
-    struct PresetData
-    {
-        juce::String name;
-        float drive, mix, inputGain, outputGain;
-        juce::String algorithm;
-        float delayTime, feedback, delayMix;
-        bool pingPong;
-        juce::String filterType;
-        float frequency, resonance;
-        float pulseMix;
-        juce::String pulseRate;
-    };
-
-    PresetData presets[] = {
-        {"Default", 0.5f, 0.5f, 0.0f, 0.0f, "soft_clip", 0.5f, 0.4f, 0.3f, false, "lowpass", 1000.0f, 0.7f, 0.0f, "1/4"},
-        {"Light Drive", 0.3f, 0.5f, 0.2f, 0.5f, "soft_clip", 0.5f, 0.4f, 0.3f, false, "lowpass", 1200.0f, 0.5f, 0.2f, "1/4"},
-        {"Heavy Metal", 0.8f, 0.7f, 3.0f, 2.0f, "hard_clip", 0.5f, 0.5f, 0.5f, true, "lowpass", 2000.0f, 1.2f, 0.4f, "1/4"},
-        {"Fuzz", 1.0f, 1.0f, 6.0f, -3.0f, "foldback", 0.7f, 0.7f, 0.6f, false, "highpass", 500.0f, 0.8f, 1.0f, "1/4"},
-        {"Warm Tape", 0.5f, 0.4f, 1.5f, 0.0f, "waveshaper", 0.3f, 0.6f, 0.4f, true, "bandpass", 1500.0f, 2.0f, 0.6f, "1/4"},
-        {"Subtle Texture", 0.25f, 0.35f, 1.0f, 0.0f, "waveshaper", 0.2f, 0.25f, 0.2f, true, "highpass", 400.0f, 0.5f, 0.15f, "1/8"},
-        {"Rhythmic Grind", 0.7f, 0.8f, 2.5f, -1.5f, "hard_clip", 0.25f, 0.6f, 0.5f, true, "bandpass", 1200.0f, 3.0f, 0.8f, "1/8"},
-        {"Analog Crush", 0.9f, 0.65f, 4.0f, -2.0f, "bitcrusher", 0.15f, 0.3f, 0.25f, false, "lowpass", 1800.0f, 1.0f, 0.3f, "1/4"},
-        {"Ambient Wash", 0.4f, 0.6f, 1.0f, 0.5f, "soft_clip", 0.9f, 0.75f, 0.8f, true, "lowpass", 3000.0f, 0.3f, 0.2f, "1/2"},
-        {"Bass Thickener", 0.35f, 0.55f, 3.0f, -1.0f, "foldback", 0.1f, 0.2f, 0.15f, false, "lowpass", 500.0f, 1.7f, 0.4f, "1/4"},
-        {"Lo-Fi Charm", 0.6f, 0.75f, 2.0f, -1.0f, "bitcrusher", 0.35f, 0.45f, 0.4f, true, "lowpass", 2400.0f, 0.4f, 0.3f, "1/8"},
-        {"Synth Destroyer", 0.85f, 0.9f, 5.0f, -2.5f, "foldback", 0.18f, 0.65f, 0.55f, true, "bandpass", 900.0f, 4.0f, 0.7f, "1/4"},
-        {"Vocal Enhancer", 0.2f, 0.3f, 1.5f, 0.0f, "soft_clip", 0.22f, 0.3f, 0.25f, true, "highpass", 300.0f, 0.3f, 0.0f, "1/4"},
-        {"Guitar Sizzle", 0.55f, 0.7f, 3.0f, -1.0f, "waveshaper", 0.4f, 0.5f, 0.35f, false, "bandpass", 1600.0f, 1.8f, 0.2f, "1/4"},
-        {"Drum Cruncher", 0.45f, 0.6f, 2.5f, -0.5f, "hard_clip", 0.12f, 0.2f, 0.15f, false, "lowpass", 4000.0f, 0.9f, 0.5f, "1/8"}};
-
-    // Reference to processors
-    auto &distortion = processorRef.getDistortionProcessor();
-    auto &delay = processorRef.getDelayProcessor();
-    auto &filter = processorRef.getFilterProcessor();
-    auto &pulse = processorRef.getPulseProcessor();
-
-    // Create each preset
-    for (const auto &preset : presets)
-    {
-        // Make sure distortion parameters are set first
-        distortion.setAlgorithm(preset.algorithm); // Set algorithm first
-        distortion.setDrive(preset.drive);
-        distortion.setMix(preset.mix);
-        distortion.setInputGain(preset.inputGain);
-        distortion.setOutputGain(preset.outputGain);
-
-        // Set delay parameters
-        delay.setDelayTime(preset.delayTime);
-        delay.setFeedback(preset.feedback);
-        delay.setMix(preset.delayMix);
-        delay.setPingPong(preset.pingPong);
-
-        // Set filter parameters
-        filter.setFilterType(preset.filterType);
-        filter.setFrequency(preset.frequency);
-        filter.setResonance(preset.resonance);
-
-        // Set pulse parameters
-        pulse.setMix(preset.pulseMix);
-        pulse.setRate(preset.pulseRate);
-
-        // Create an XML element for this preset
-        auto presetXml = std::make_unique<juce::XmlElement>("OxidePreset");
-        presetXml->setAttribute("name", preset.name);
-        presetXml->setAttribute("version", "1.0");
-
-        // Save the current state to XML
-        saveProcessorStateToXml(presetXml.get());
-
-        // Save the preset file
-        juce::File presetFile = presetsDirectory.getChildFile(preset.name + ".xml");
-        presetXml->writeToFile(presetFile, "");
-
-        // Debug output
-        juce::Logger::writeToLog("Created preset: " + preset.name);
+            setChoice(ParameterIDs::pulseRate, PulseProcessor::getRateNames(), pulseXml->getStringAttribute("rate"));
     }
 
-    // Restore original state
-    loadProcessorStateFromXml(currentState.get());
-}
\ No newline at end of file
+    return state;
+}
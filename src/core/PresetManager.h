@@ -1,25 +1,35 @@
 #pragma once
 
 #include <JuceHeader.h>
+#include "PresetIndex.h"
+#include "PresetState.h"
 
 // Forward declare to avoid circular includes
 class OxideAudioProcessor;
 
-class PresetManager
+class PresetManager : private juce::ChangeListener
 {
 public:
     PresetManager(OxideAudioProcessor &processor);
-    ~PresetManager();
+    ~PresetManager() override;
 
     // Preset handling methods
     void savePreset(const juce::String &presetName);
+
+    // Starts loading a preset; returns false if there is no preset by that name. The file
+    // is parsed on a background thread and the result applied on the message thread, after
+    // which onPresetLoaded is called. A newer load supersedes one still in flight.
     bool loadPreset(const juce::String &presetName);
 
-    // Get preset list
+    // Called on the message thread once a preset has been applied
+    std::function<void(const juce::String &presetName)> onPresetLoaded;
+
+    // Get preset list: factory presets first, then user presets. Both are served
+    // from memory, so this never touches the disk
     juce::StringArray getPresetList();
 
-    // Create default presets if needed
-    void createDefaultPresetsIfNeeded();
+    // Called on the message thread when presets are added, removed or renamed on disk
+    std::function<void()> onPresetListChanged;
 
 private:
     // Non-owning reference to the processor
@@ -28,13 +38,34 @@ private:
     // Directory where presets are stored
     juce::File presetsDirectory;
 
+    // Shared by every instance in the process
+    juce::SharedResourcePointer<PresetIndex> presetIndex;
+
+    // Read-only factory presets, parsed from BinaryData once per process
+    struct FactoryBank;
+    juce::SharedResourcePointer<FactoryBank> factoryBank;
+
+    // Background thread presets are parsed on, shared by every instance
+    struct LoaderPool;
+    juce::SharedResourcePointer<LoaderPool> loaderPool;
+
+    // Bumped by every load, so only the most recent one is applied
+    juce::uint32 loadGeneration = 0;
+
     // Helper methods
     juce::File getUserPresetsDirectory() const;
     void saveProcessorStateToXml(juce::XmlElement *xml);
-    void loadProcessorStateFromXml(const juce::XmlElement *xml);
+    PresetState getCurrentState() const;
+
+    // Overlays a preset's values on state; attributes the preset lacks keep their value.
+    // Touches nothing but its arguments, so it runs on the loader thread.
+    static PresetState parsePresetState(const juce::XmlElement &xml, PresetState state);
+
+    void changeListenerCallback(juce::ChangeBroadcaster *) override;
 
     // Flag to prevent recursive operations
     bool isInitialized = false;
 
+    JUCE_DECLARE_WEAK_REFERENCEABLE(PresetManager)
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(PresetManager)
 };
\ No newline at end of file
@@ -0,0 +1,30 @@
+#pragma once
+
+#include <JuceHeader.h>
+#include "ParameterIDs.h"
+#include <string_view>
+
+// A whole preset as plain parameter values (choice parameters as indices), one per
+// entry in ParameterIDs::bridgeOrder. Built off the message thread and not modified
+// once it has been handed to the processor.
+struct PresetState
+{
+    static constexpr size_t numParameters = ParameterIDs::bridgeOrder.size();
+
+    // Position of a parameter in values
+    static size_t indexOf(const char *parameterId)
+    {
+        for (size_t i = 0; i < numParameters; ++i)
+            if (std::string_view(ParameterIDs::bridgeOrder[i]) == parameterId)
+                return i;
+
+        jassertfalse;
+        return 0;
+    }
+
+    float get(const char *parameterId) const { return values[indexOf(parameterId)]; }
+    void set(const char *parameterId, float plainValue) { values[indexOf(parameterId)] = plainValue; }
+
+    juce::String name;
+    std::array<float, numParameters> values{};
+};
@@ -0,0 +1,83 @@
+#pragma once
+
+#include <JuceHeader.h>
+
+// Linear parameter smoother that is advanced a whole block at a time.
+//
+// A steady value costs one comparison per block. While a ramp is running, callers
+// take the value at the start of the block (getCurrentValue) and at the end (skip)
+// and interpolate between the two inside their own kernels, either per sample for
+// gains or every controlInterval samples for things like filter coefficients.
+class BlockSmoother
+{
+public:
+    // Coefficient-style parameters are recomputed this often while ramping
+    static constexpr int controlInterval = 32;
+
+    BlockSmoother() = default;
+
+    void reset(double sampleRate, double rampLengthSeconds)
+    {
+        rampLengthSamples = juce::jmax(1, juce::roundToInt(sampleRate * rampLengthSeconds));
+        setCurrentAndTargetValue(target);
+    }
+
+    void setCurrentAndTargetValue(float newValue)
+    {
+        current = target = newValue;
+        step = 0.0f;
+        countdown = 0;
+    }
+
+    void setTargetValue(float newValue)
+    {
+        if (newValue == target)
+            return;
+
+        // Not prepared yet, so there is nothing to ramp over
+        if (rampLengthSamples <= 0)
+        {
+            setCurrentAndTargetValue(newValue);
+            return;
+        }
+
+        target = newValue;
+        countdown = rampLengthSamples;
+        step = (target - current) / static_cast<float>(countdown);
+    }
+
+    bool isSmoothing() const noexcept { return countdown > 0; }
+    float getCurrentValue() const noexcept { return current; }
+    float getTargetValue() const noexcept { return target; }
+
+    // Advances the ramp by numSamples and returns the value reached
+    float skip(int numSamples) noexcept
+    {
+        if (countdown <= 0)
+            return current;
+
+        if (numSamples >= countdown)
+        {
+            countdown = 0;
+            current = target;
+        }
+        else
+        {
+            countdown -= numSamples;
+            current += step * static_cast<float>(numSamples);
+        }
+
+        return current;
+    }
+
+    float getNextValue() noexcept { return skip(1); }
+
+private:
+    float current = 0.0f;
+    float target = 0.0f;
+    float step = 0.0f;
+    int countdown = 0;
+    int rampLengthSamples = 0;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(BlockSmoother)
+};
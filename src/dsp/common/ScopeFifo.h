@@ -0,0 +1,94 @@
+#pragma once
+
+#include <JuceHeader.h>
+
+// Single-producer/single-consumer sample FIFO carrying the oscilloscope signal from
+// the audio thread to the UI.
+//
+// The audio thread pushes each block (mixed to mono) and the UI drains whatever has
+// arrived since its last frame. Both sides are wait-free: no locks, and no allocation
+// after construction. If the UI stalls long enough to fill the FIFO, the producer keeps
+// what fits and drops the rest rather than waiting; the reader picks up again from
+// there on its next frame.
+class ScopeFifo
+{
+public:
+    // Fixed size, so the storage never moves under a reader: about 0.7 s at 44.1 kHz and
+    // 0.17 s at 192 kHz, which is still several UI frames
+    static constexpr int capacity = 1 << 15;
+
+    ScopeFifo() : fifo(capacity), samples(static_cast<size_t>(capacity), 0.0f) {}
+
+    // Call from prepareToPlay. The positions are never reset from this side, since a UI
+    // frame may be reading at the same time; the reader drops its backlog instead when it
+    // next sees the generation move.
+    void prepare()
+    {
+        generation.fetch_add(1, std::memory_order_release);
+    }
+
+    // Audio thread only
+    void push(const juce::AudioBuffer<float> &buffer)
+    {
+        const int numChannels = buffer.getNumChannels();
+        if (numChannels == 0)
+            return;
+
+        const float *left = buffer.getReadPointer(0);
+        const float *right = numChannels > 1 ? buffer.getReadPointer(1) : nullptr;
+
+        const auto scope = fifo.write(buffer.getNumSamples());
+
+        auto writeSegment = [&](int destinationIndex, int sourceIndex, int numSamples)
+        {
+            float *destination = samples.data() + destinationIndex;
+
+            if (right != nullptr)
+            {
+                juce::FloatVectorOperations::copyWithMultiply(destination, left + sourceIndex, 0.5f, numSamples);
+                juce::FloatVectorOperations::addWithMultiply(destination, right + sourceIndex, 0.5f, numSamples);
+            }
+            else
+            {
+                juce::FloatVectorOperations::copy(destination, left + sourceIndex, numSamples);
+            }
+        };
+
+        if (scope.blockSize1 > 0)
+            writeSegment(scope.startIndex1, 0, scope.blockSize1);
+        if (scope.blockSize2 > 0)
+            writeSegment(scope.startIndex2, scope.blockSize1, scope.blockSize2);
+    }
+
+    // Message thread only. Copies up to numSamples of the oldest pending samples and
+    // returns how many were read.
+    int pop(float *destination, int numSamples)
+    {
+        // Samples from before the last prepare() belong to the old stream
+        const auto currentGeneration = generation.load(std::memory_order_acquire);
+        if (currentGeneration != readGeneration)
+        {
+            readGeneration = currentGeneration;
+            fifo.finishedRead(fifo.getNumReady());
+        }
+
+        const auto scope = fifo.read(numSamples);
+
+        if (scope.blockSize1 > 0)
+            juce::FloatVectorOperations::copy(destination, samples.data() + scope.startIndex1, scope.blockSize1);
+        if (scope.blockSize2 > 0)
+            juce::FloatVectorOperations::copy(destination + scope.blockSize1, samples.data() + scope.startIndex2, scope.blockSize2);
+
+        return scope.blockSize1 + scope.blockSize2;
+    }
+
+private:
+    juce::AbstractFifo fifo;
+    std::vector<float> samples;
+
+    // Bumped by prepare(); readGeneration is the reader's copy (message thread only)
+    std::atomic<juce::uint32> generation{0};
+    juce::uint32 readGeneration = 0;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(ScopeFifo)
+};
@@ -0,0 +1,37 @@
+#pragma once
+
+#include <JuceHeader.h>
+
+// Per-instance scratch memory shared by the processing stages.
+// Sized once in prepareToPlay so that processBlock never touches the allocator.
+// The stages run one after another, so a single dry buffer is enough for all of them.
+class ScratchArena
+{
+public:
+    ScratchArena() = default;
+
+    void prepare(int numChannels, int maxBlockSize)
+    {
+        capacityChannels = numChannels;
+        capacitySamples = maxBlockSize;
+        dryBuffer.setSize(numChannels, maxBlockSize, false, true, false);
+    }
+
+    // Copies the block into the preallocated dry buffer and returns it.
+    // Does not allocate as long as the block fits the size given to prepare().
+    juce::AudioBuffer<float> &copyOf(const juce::AudioBuffer<float> &source)
+    {
+        jassert(source.getNumChannels() <= capacityChannels &&
+                source.getNumSamples() <= capacitySamples);
+
+        dryBuffer.makeCopyOf(source, true);
+        return dryBuffer;
+    }
+
+private:
+    juce::AudioBuffer<float> dryBuffer;
+    int capacityChannels = 0;
+    int capacitySamples = 0;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(ScratchArena)
+};
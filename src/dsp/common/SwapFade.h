@@ -0,0 +1,76 @@
+#pragma once
+
+#include <JuceHeader.h>
+
+// Short output dip used to swap a whole set of settings in without clicks: the output
+// fades out on the old settings, the caller applies the new ones once it is silent, and
+// it fades back in. The stages are single stateful instances, so a dip costs nothing
+// extra where a true crossfade would need a second copy of the whole chain.
+//
+// Audio thread only, apart from prepare().
+class SwapFade
+{
+public:
+    static constexpr double fadeSeconds = 0.005;
+
+    // Call from prepareToPlay, while the audio thread is stopped
+    void prepare(double sampleRate)
+    {
+        fadeSamples = juce::jmax(1, juce::roundToInt(sampleRate * fadeSeconds));
+        gain = 1.0f;
+        state = State::idle;
+    }
+
+    // Starts fading out from wherever the gain is now, even part way through a fade in
+    void beginFadeOut() noexcept { state = State::fadingOut; }
+    void beginFadeIn() noexcept { state = State::fadingIn; }
+
+    bool isFadingOut() const noexcept { return state == State::fadingOut; }
+
+    // Whether the output has gone quiet and the new settings can be applied
+    bool isSilent() const noexcept { return state == State::fadingOut && gain <= 0.0f; }
+
+    void process(juce::AudioBuffer<float> &buffer) noexcept
+    {
+        if (state == State::idle)
+            return;
+
+        const int numSamples = buffer.getNumSamples();
+        const float target = state == State::fadingOut ? 0.0f : 1.0f;
+        const int samplesToTarget = static_cast<int>(std::ceil(std::abs(target - gain) * static_cast<float>(fadeSamples)));
+        const int rampSamples = juce::jmin(numSamples, samplesToTarget);
+
+        const float direction = target > gain ? 1.0f : -1.0f;
+        const float endGain = rampSamples == samplesToTarget
+                                  ? target
+                                  : gain + direction * static_cast<float>(rampSamples) / static_cast<float>(fadeSamples);
+
+        for (int channel = 0; channel < buffer.getNumChannels(); ++channel)
+        {
+            buffer.applyGainRamp(channel, 0, rampSamples, gain, endGain);
+
+            // Once faded out, the rest of the block stays silent until the swap
+            if (endGain <= 0.0f)
+                buffer.clear(channel, rampSamples, numSamples - rampSamples);
+        }
+
+        gain = endGain;
+
+        if (state == State::fadingIn && gain >= 1.0f)
+            state = State::idle;
+    }
+
+private:
+    enum class State
+    {
+        idle,
+        fadingOut,
+        fadingIn
+    };
+
+    State state = State::idle;
+    float gain = 1.0f;
+    int fadeSamples = 1;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(SwapFade)
+};
@@ -6,8 +6,18 @@ DelayProcessor::DelayProcessor()
       mix(0.3f),              // 30% default mix
       filterFreq(5000.0f),    // 5kHz default filter cutoff
       pingPongEnabled(false), // Ping-pong disabled by default
+      syncEnabled(false),     // Free running by default
+      noteValue(7),           // 1/4 note when synced
+      currentBpm(120.0),
       currentSampleRate(44100.0),
-      bufferSize(0)
+      currentDelaySamples(0.0f),
+      nextDelaySamples(0.0f),
+      crossfadeLength(1),
+      crossfadeRemaining(0),
+      appliedFilterFreq(5000.0f),
+      bufferSize(0),
+      bufferMask(0),
+      writePosition(0)
 {
 }
 
@@ -15,129 +25,296 @@ void DelayProcessor::prepare(double sampleRate, int maxBlockSize)
 {
     currentSampleRate = sampleRate;
 
-    // Allocate a 2-second buffer at the current sample rate (more than enough for 2.0s max delay)
-    bufferSize = static_cast<int>(currentSampleRate * 2.0);
+    // Room for the 2 second maximum delay plus the interpolation tap, rounded up to a
+    // power of two so positions wrap with a mask
+    bufferSize = juce::nextPowerOfTwo(static_cast<int>(std::ceil(currentSampleRate * 2.0)) + 2);
+    bufferMask = bufferSize - 1;
+    writePosition = 0;
 
-    // Clear and resize delay buffers
-    delayBuffers.clear();
-    writePositions.clear();
+    // Create 2 channels for stereo processing
+    delayBuffer.setSize(2, bufferSize);
+    delayBuffer.clear();
+
+    tapScratch.setSize(2, maxBlockSize + 1);
+    feedbackScratch.setSize(2, maxBlockSize);
+
+    // Create feedback filters
     filters.clear();
+    appliedFilterFreq = filterFreq.load();
 
-    // Create 2 buffers for stereo processing
     for (int i = 0; i < 2; ++i)
     {
-        // Create delay buffer
-        auto delayBuffer = std::make_unique<juce::AudioBuffer<float>>(1, bufferSize);
-        delayBuffer->clear();
-        delayBuffers.push_back(std::move(delayBuffer));
-
-        // Initialize write position
-        writePositions.push_back(0);
-
-        // Create feedback filter
         auto filter = std::make_unique<juce::IIRFilter>();
-        filter->setCoefficients(juce::IIRCoefficients::makeLowPass(currentSampleRate, filterFreq));
+        filter->setCoefficients(juce::IIRCoefficients::makeLowPass(currentSampleRate, appliedFilterFreq));
         filters.push_back(std::move(filter));
     }
+
+    feedbackSmoother.reset(sampleRate, 0.02);
+    mixSmoother.reset(sampleRate, 0.02);
+    feedbackSmoother.setCurrentAndTargetValue(feedback.load());
+    mixSmoother.setCurrentAndTargetValue(mix.load());
+
+    // 50ms crossfade between taps when the delay time changes
+    crossfadeLength = juce::jmax(1, juce::roundToInt(sampleRate * 0.05));
+    crossfadeRemaining = 0;
+    currentDelaySamples = nextDelaySamples = calculateDelaySamples(getEffectiveDelayTime());
 }
 
 void DelayProcessor::processBlock(juce::AudioBuffer<float> &buffer)
 {
-    const int numChannels = buffer.getNumChannels();
+    const int numChannels = juce::jmin(buffer.getNumChannels(), 2);
     const int numSamples = buffer.getNumSamples();
 
     // Early return if we haven't been prepared yet
-    if (bufferSize == 0 || delayBuffers.empty())
+    if (bufferSize == 0 || filters.empty() || numSamples == 0)
         return;
 
-    // Create a buffer for the dry signal
-    juce::AudioBuffer<float> dryBuffer;
-    dryBuffer.makeCopyOf(buffer);
+    // Snapshot the parameters once so the whole block sees a consistent state
+    const float targetDelaySamples = calculateDelaySamples(getEffectiveDelayTime());
+    feedbackSmoother.setTargetValue(feedback.load());
+    mixSmoother.setTargetValue(mix.load());
+    const float filterFreqValue = filterFreq.load();
 
-    // Calculate delay time in samples with room for interpolation
-    float delaySamples = calculateDelaySamples();
+    // Rebuild the feedback filter coefficients here rather than in the setter
+    if (filterFreqValue != appliedFilterFreq)
+    {
+        appliedFilterFreq = filterFreqValue;
+        const auto coefficients = juce::IIRCoefficients::makeLowPass(currentSampleRate, appliedFilterFreq);
+        for (auto &filter : filters)
+            filter->setCoefficients(coefficients);
+    }
 
-    // Process each channel
-    for (int channel = 0; channel < numChannels && channel < 2; ++channel)
+    // Start a crossfade towards a new delay time unless one is already running
+    if (crossfadeRemaining == 0 && targetDelaySamples != currentDelaySamples)
     {
-        float *channelData = buffer.getWritePointer(channel);
-        float *delayData = delayBuffers[channel]->getWritePointer(0);
+        nextDelaySamples = targetDelaySamples;
+        crossfadeRemaining = crossfadeLength;
+    }
 
-        int channelForFeedback = channel;
+    // Smoothed values at the block edges, interpolated per sample below
+    const float feedbackStart = feedbackSmoother.getCurrentValue();
+    const float mixStart = mixSmoother.getCurrentValue();
+    const float scale = 1.0f / static_cast<float>(numSamples);
+    const float feedbackStep = (feedbackSmoother.skip(numSamples) - feedbackStart) * scale;
+    const float mixStep = (mixSmoother.skip(numSamples) - mixStart) * scale;
 
-        // In ping-pong mode, left channel feeds into right and vice versa
-        if (pingPongEnabled && numChannels > 1)
-        {
-            channelForFeedback = 1 - channel;
-        }
+    const Routing routing = makeRouting(pingPongEnabled.load(), numChannels);
+
+    if (crossfadeRemaining == 0)
+        processSegments(buffer, numChannels, routing, currentDelaySamples, feedbackStart, feedbackStep, mixStart, mixStep);
+    else
+        processCrossfade(buffer, numChannels, routing, feedbackStart, feedbackStep, mixStart, mixStep);
+
+    writePosition = (writePosition + numSamples) & bufferMask;
+}
+
+DelayProcessor::Routing DelayProcessor::makeRouting(bool pingPong, int numChannels) const
+{
+    // Ping-pong sends the mono sum into the left ring only and swaps the feedback
+    // between rings, so each repeat lands on the opposite side
+    if (pingPong && numChannels > 1)
+        return {{0.5f, 0.0f}, {0.5f, 0.0f}, 0.0f, 1.0f};
+
+    // Independent channels: each ring hears its own input and its own repeats
+    return {{1.0f, 1.0f}, {0.0f, 0.0f}, 1.0f, 0.0f};
+}
+
+void DelayProcessor::processSegments(juce::AudioBuffer<float> &buffer, int numChannels, const Routing &routing,
+                                     float delaySamples, float feedbackStart, float feedbackStep,
+                                     float mixStart, float mixStep)
+{
+    const int numSamples = buffer.getNumSamples();
+
+    // Split the delay into whole samples and the linear interpolation weight
+    const int wholeDelay = juce::jlimit(1, bufferSize - 2, static_cast<int>(delaySamples));
+    const float fraction = juce::jlimit(0.0f, 1.0f, delaySamples - static_cast<float>(wholeDelay));
+    const int maxChunk = juce::jmin(wholeDelay, feedbackScratch.getNumSamples());
+
+    // A mono buffer runs the left lane only
+    const int lastChannel = numChannels - 1;
+
+    for (int offset = 0; offset < numSamples; offset += maxChunk)
+    {
+        const int length = juce::jmin(maxChunk, numSamples - offset);
+        const int chunkWrite = (writePosition + offset) & bufferMask;
 
-        for (int sample = 0; sample < numSamples; ++sample)
+        // Read length + 1 raw samples and interpolate between neighbours:
+        // out[n] = ring[w + n - d - 1] * fraction + ring[w + n - d] * (1 - fraction)
+        for (int channel = 0; channel < numChannels; ++channel)
         {
-            // Get the current write position
-            int writePos = writePositions[channel];
+            float *taps = tapScratch.getWritePointer(channel);
+            float *feedbackSignal = feedbackScratch.getWritePointer(channel);
 
-            // Calculate the read position with interpolation
-            float readPos = static_cast<float>(writePos) - delaySamples;
-            if (readPos < 0)
-                readPos += bufferSize;
+            readRing(channel, (chunkWrite - wholeDelay - 1) & bufferMask, taps, length + 1);
 
-            // Get the delayed sample with interpolation
-            float delaySample = getInterpolatedSample(delayData, bufferSize, readPos);
+            for (int i = 0; i < length; ++i)
+                taps[i] = taps[i] * fraction + taps[i + 1] * (1.0f - fraction);
 
-            // Apply filter to the feedback signal
-            float filteredSample = filters[channel]->processSingleSampleRaw(delaySample);
+            // Filtered repeats for the feedback path
+            juce::FloatVectorOperations::copy(feedbackSignal, taps, length);
+            filters[channel]->processSamples(feedbackSignal, length);
+        }
 
-            // Write to the delay buffer (current input + filtered feedback)
-            float inputWithFeedback = channelData[sample] + filteredSample * feedback;
-            delayData[writePos] = inputWithFeedback;
+        // Stereo kernel: both lanes are combined in the same iteration, so the
+        // cross-feedback of ping-pong costs nothing extra
+        const float *inputL = buffer.getReadPointer(0, offset);
+        const float *inputR = buffer.getReadPointer(lastChannel, offset);
+        float *feedbackL = feedbackScratch.getWritePointer(0);
+        float *feedbackR = feedbackScratch.getWritePointer(lastChannel);
 
-            // Apply the wet/dry mix
-            channelData[sample] = channelData[sample] * (1.0f - mix) + delaySample * mix;
+        for (int i = 0; i < length; ++i)
+        {
+            const float feedbackAmount = feedbackStart + feedbackStep * static_cast<float>(offset + i);
+            const float repeatL = feedbackL[i] * feedbackAmount;
+            const float repeatR = feedbackR[i] * feedbackAmount;
+
+            feedbackL[i] = inputL[i] * routing.sameInput[0] + inputR[i] * routing.otherInput[0] +
+                           repeatL * routing.sameFeedback + repeatR * routing.crossFeedback;
+            feedbackR[i] = inputR[i] * routing.sameInput[1] + inputL[i] * routing.otherInput[1] +
+                           repeatR * routing.sameFeedback + repeatL * routing.crossFeedback;
+        }
+
+        for (int channel = 0; channel < numChannels; ++channel)
+        {
+            writeRing(channel, chunkWrite, feedbackScratch.getReadPointer(channel), length);
 
-            // Increment and wrap the write position
-            writePositions[channel] = (writePos + 1) % bufferSize;
+            // Apply the wet/dry mix
+            float *output = buffer.getWritePointer(channel, offset);
+            const float *taps = tapScratch.getReadPointer(channel);
+
+            for (int i = 0; i < length; ++i)
+            {
+                const float mixAmount = mixStart + mixStep * static_cast<float>(offset + i);
+                output[i] = output[i] * (1.0f - mixAmount) + taps[i] * mixAmount;
+            }
         }
     }
 }
 
-void DelayProcessor::reset()
+void DelayProcessor::processCrossfade(juce::AudioBuffer<float> &buffer, int numChannels, const Routing &routing,
+                                      float feedbackStart, float feedbackStep, float mixStart, float mixStep)
 {
-    for (auto &buffer : delayBuffers)
+    const int numSamples = buffer.getNumSamples();
+    const int lastChannel = numChannels - 1;
+
+    float *channelL = buffer.getWritePointer(0);
+    float *channelR = buffer.getWritePointer(lastChannel);
+    float *delayL = delayBuffer.getWritePointer(0);
+    float *delayR = delayBuffer.getWritePointer(lastChannel);
+    auto &filterL = *filters[0];
+    auto &filterR = *filters[static_cast<size_t>(lastChannel)];
+
+    // Both taps sit at fixed delays for the whole block; only the fade weight moves
+    const int wholeFrom = static_cast<int>(currentDelaySamples);
+    const float fractionFrom = currentDelaySamples - static_cast<float>(wholeFrom);
+    const int wholeTo = static_cast<int>(nextDelaySamples);
+    const float fractionTo = nextDelaySamples - static_cast<float>(wholeTo);
+
+    const float fadeStep = 1.0f / static_cast<float>(crossfadeLength);
+    float fade = 1.0f - static_cast<float>(crossfadeRemaining) * fadeStep;
+
+    auto readTap = [this](const float *ring, int writePos, int whole, float fraction)
     {
-        buffer->clear();
-    }
+        return ring[(writePos - whole - 1) & bufferMask] * fraction + ring[(writePos - whole) & bufferMask] * (1.0f - fraction);
+    };
 
-    for (auto &filter : filters)
+    for (int sample = 0; sample < numSamples; ++sample)
     {
-        filter->reset();
+        const int writePos = (writePosition + sample) & bufferMask;
+
+        const float position = static_cast<float>(sample);
+        const float feedbackAmount = feedbackStart + feedbackStep * position;
+        const float mixAmount = mixStart + mixStep * position;
+
+        fade = juce::jmin(1.0f, fade + fadeStep);
+
+        const float fromL = readTap(delayL, writePos, wholeFrom, fractionFrom);
+        const float fromR = readTap(delayR, writePos, wholeFrom, fractionFrom);
+        const float tapL = fromL + (readTap(delayL, writePos, wholeTo, fractionTo) - fromL) * fade;
+        const float tapR = fromR + (readTap(delayR, writePos, wholeTo, fractionTo) - fromR) * fade;
+
+        // Apply filter to the feedback signal
+        const float repeatL = filterL.processSingleSampleRaw(tapL) * feedbackAmount;
+        const float repeatR = numChannels > 1 ? filterR.processSingleSampleRaw(tapR) * feedbackAmount : repeatL;
+
+        // Write to the delay buffer (routed input + filtered feedback)
+        const float inputL = channelL[sample];
+        const float inputR = channelR[sample];
+        delayL[writePos] = inputL * routing.sameInput[0] + inputR * routing.otherInput[0] +
+                           repeatL * routing.sameFeedback + repeatR * routing.crossFeedback;
+        delayR[writePos] = inputR * routing.sameInput[1] + inputL * routing.otherInput[1] +
+                           repeatR * routing.sameFeedback + repeatL * routing.crossFeedback;
+
+        // Apply the wet/dry mix
+        channelL[sample] = inputL * (1.0f - mixAmount) + tapL * mixAmount;
+        channelR[sample] = inputR * (1.0f - mixAmount) + tapR * mixAmount;
     }
+
+    // Once the new tap is fully in, it becomes the only one
+    crossfadeRemaining = juce::jmax(0, crossfadeRemaining - numSamples);
+    if (crossfadeRemaining == 0)
+        currentDelaySamples = nextDelaySamples;
 }
 
-float DelayProcessor::calculateDelaySamples() const
+void DelayProcessor::readRing(int channel, int startPosition, float *destination, int numSamples) const
 {
-    // Convert delay time in seconds to samples
-    return delayTime * static_cast<float>(currentSampleRate);
+    const float *ring = delayBuffer.getReadPointer(channel);
+    const int firstPart = juce::jmin(numSamples, bufferSize - startPosition);
+
+    juce::FloatVectorOperations::copy(destination, ring + startPosition, firstPart);
+
+    if (firstPart < numSamples)
+        juce::FloatVectorOperations::copy(destination + firstPart, ring, numSamples - firstPart);
 }
 
-int DelayProcessor::getReadPosition(int writePosition, float delaySamples) const
+void DelayProcessor::writeRing(int channel, int startPosition, const float *source, int numSamples)
 {
-    int readPos = static_cast<int>(writePosition - delaySamples);
+    float *ring = delayBuffer.getWritePointer(channel);
+    const int firstPart = juce::jmin(numSamples, bufferSize - startPosition);
+
+    juce::FloatVectorOperations::copy(ring + startPosition, source, firstPart);
 
-    // Wrap around if needed
-    while (readPos < 0)
-        readPos += bufferSize;
+    if (firstPart < numSamples)
+        juce::FloatVectorOperations::copy(ring, source + firstPart, numSamples - firstPart);
+}
 
-    return readPos % bufferSize;
+void DelayProcessor::reset()
+{
+    delayBuffer.clear();
+    writePosition = 0;
+
+    for (auto &filter : filters)
+    {
+        filter->reset();
+    }
 }
 
-float DelayProcessor::getInterpolatedSample(const float *bufferData, int bufferSize, float readPos) const
+float DelayProcessor::calculateDelaySamples(float delayTimeSeconds) const
 {
-    // Linear interpolation between two adjacent samples
-    int pos1 = static_cast<int>(readPos);
-    int pos2 = (pos1 + 1) % bufferSize;
-    float frac = readPos - static_cast<float>(pos1);
+    // Convert delay time in seconds to samples, leaving room in the ring for interpolation
+    const float maxDelay = bufferSize > 2 ? static_cast<float>(bufferSize - 2) : 1.0f;
+    return juce::jlimit(1.0f, maxDelay, delayTimeSeconds * static_cast<float>(currentSampleRate));
+}
 
-    return bufferData[pos1] * (1.0f - frac) + bufferData[pos2] * frac;
+float DelayProcessor::getEffectiveDelayTime() const
+{
+    if (!syncEnabled.load())
+        return delayTime.load();
+
+    // Length in quarter notes for each entry of getNoteValueNames()
+    static constexpr double beats[] = {
+        0.25 * 2.0 / 3.0, 0.25, 0.25 * 1.5, // 1/16
+        0.5 * 2.0 / 3.0, 0.5, 0.5 * 1.5,    // 1/8
+        1.0 * 2.0 / 3.0, 1.0, 1.0 * 1.5,    // 1/4
+        2.0 * 2.0 / 3.0, 2.0, 2.0 * 1.5,    // 1/2
+        4.0 * 2.0 / 3.0, 4.0, 4.0 * 1.5     // 1/1
+    };
+
+    const int index = juce::jlimit(0, static_cast<int>(std::size(beats)) - 1, noteValue.load());
+    const double seconds = beats[index] * 60.0 / currentBpm.load();
+
+    // Long notes at slow tempos are limited to the 2 second buffer
+    return static_cast<float>(juce::jlimit(0.01, 2.0, seconds));
 }
 
 void DelayProcessor::setDelayTime(float newDelayTime)
@@ -158,13 +335,8 @@ void DelayProcessor::setMix(float newMix)
 
 void DelayProcessor::setFilterFreq(float newFrequency)
 {
+    // Coefficients are recomputed by processBlock on the audio thread
     filterFreq = juce::jlimit(20.0f, 20000.0f, newFrequency);
-
-    // Update filter coefficients
-    for (auto &filter : filters)
-    {
-        filter->setCoefficients(juce::IIRCoefficients::makeLowPass(currentSampleRate, filterFreq));
-    }
 }
 
 void DelayProcessor::setPingPong(bool enabled)
@@ -172,6 +344,21 @@ void DelayProcessor::setPingPong(bool enabled)
     pingPongEnabled = enabled;
 }
 
+void DelayProcessor::setSync(bool enabled)
+{
+    syncEnabled = enabled;
+}
+
+void DelayProcessor::setNoteValue(int noteIndex)
+{
+    noteValue = juce::jlimit(0, numNoteValues - 1, noteIndex);
+}
+
+void DelayProcessor::setBpm(double newBpm)
+{
+    currentBpm = juce::jlimit(20.0, 300.0, newBpm);
+}
+
 float DelayProcessor::getDelayTime() const
 {
     return delayTime;
@@ -195,4 +382,28 @@ float DelayProcessor::getFilterFreq() const
 bool DelayProcessor::getPingPong() const
 {
     return pingPongEnabled;
+}
+
+bool DelayProcessor::getSync() const
+{
+    return syncEnabled;
+}
+
+int DelayProcessor::getNoteValue() const
+{
+    return noteValue;
+}
+
+juce::String DelayProcessor::getNoteValueName() const
+{
+    return getNoteValueNames()[noteValue.load()];
+}
+
+juce::StringArray DelayProcessor::getNoteValueNames()
+{
+    return {"1/16T", "1/16", "1/16D",
+            "1/8T", "1/8", "1/8D",
+            "1/4T", "1/4", "1/4D",
+            "1/2T", "1/2", "1/2D",
+            "1/1T", "1/1", "1/1D"};
 }
\ No newline at end of file
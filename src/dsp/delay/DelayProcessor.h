@@ -1,6 +1,7 @@
 #pragma once
 
 #include <JuceHeader.h>
+#include "BlockSmoother.h"
 
 class DelayProcessor
 {
@@ -19,36 +20,100 @@ public:
     void setFilterFreq(float newFrequency); // 20 - 20000 Hz
     void setPingPong(bool enabled);         // stereo ping-pong effect
 
+    // Tempo sync: when enabled the delay follows a note value at the host tempo
+    // instead of the time in seconds
+    void setSync(bool enabled);
+    void setNoteValue(int noteIndex); // index into getNoteValueNames()
+    void setBpm(double newBpm);
+
     // Parameter getters
     float getDelayTime() const;
     float getFeedback() const;
     float getMix() const;
     float getFilterFreq() const;
     bool getPingPong() const;
+    bool getSync() const;
+    int getNoteValue() const;
+    juce::String getNoteValueName() const;
+
+    // Note value identifiers in parameter order ("1/8", dotted "1/8D", triplet "1/8T")
+    static juce::StringArray getNoteValueNames();
+    static constexpr int numNoteValues = 15;
 
 private:
-    // Parameters
-    float delayTime;      // Delay time in seconds
-    float feedback;       // Feedback amount
-    float mix;            // Wet/dry mix
-    float filterFreq;     // Filter cutoff frequency
-    bool pingPongEnabled; // Stereo ping-pong mode
+    // Parameters (atomics so the UI can read them while the audio thread runs)
+    std::atomic<float> delayTime;      // Delay time in seconds
+    std::atomic<float> feedback;       // Feedback amount
+    std::atomic<float> mix;            // Wet/dry mix
+    std::atomic<float> filterFreq;     // Filter cutoff frequency
+    std::atomic<bool> pingPongEnabled; // Stereo ping-pong mode
+    std::atomic<bool> syncEnabled;     // Follow the host tempo
+    std::atomic<int> noteValue;        // Synced note value index
+    std::atomic<double> currentBpm;    // Host tempo
 
     // Internal state
     double currentSampleRate;
+
+    // Per-block ramps towards the parameter snapshot
+    BlockSmoother feedbackSmoother;
+    BlockSmoother mixSmoother;
+
+    // Delay time changes crossfade from a tap at the old time to a tap at the new
+    // one, so the read head never moves and nothing is recomputed per sample.
+    // A change that arrives mid-fade starts once the current fade has finished.
+    float currentDelaySamples;
+    float nextDelaySamples;
+    int crossfadeLength;
+    int crossfadeRemaining;
+
+    // Cutoff the feedback filters currently use; coefficients are rebuilt on the audio thread
+    float appliedFilterFreq;
+
+    // Power-of-two delay ring, one channel per input channel. Positions wrap with a
+    // mask, and both channels share the write position.
+    juce::AudioBuffer<float> delayBuffer;
     int bufferSize;
+    int bufferMask;
+    int writePosition;
 
-    // Delay buffers for each channel
-    std::vector<std::unique_ptr<juce::AudioBuffer<float>>> delayBuffers;
-    std::vector<int> writePositions;
+    // Scratch for the block path: the interpolated taps and the feedback signal per channel
+    juce::AudioBuffer<float> tapScratch;
+    juce::AudioBuffer<float> feedbackScratch;
 
     // Filter for feedback path
     std::vector<std::unique_ptr<juce::IIRFilter>> filters;
 
+    // How input and filtered feedback are mixed into each ring, chosen once per block.
+    // Ping-pong is just a different set of weights, so both modes cost the same.
+    struct Routing
+    {
+        float sameInput[2];   // Channel's own input into its ring
+        float otherInput[2];  // Opposite channel's input into the ring
+        float sameFeedback;   // Ring's own filtered tap
+        float crossFeedback;  // Opposite ring's filtered tap
+    };
+
+    Routing makeRouting(bool pingPong, int numChannels) const;
+
+    // Block path for a steady delay time. Works in chunks no longer than the delay,
+    // so every tap a chunk reads was written by an earlier chunk. Both channels are
+    // handled together in each chunk so feedback can cross between them.
+    void processSegments(juce::AudioBuffer<float> &buffer, int numChannels, const Routing &routing, float delaySamples,
+                         float feedbackStart, float feedbackStep, float mixStart, float mixStep);
+
+    // Per-sample path used while crossfading between the old and new delay time
+    void processCrossfade(juce::AudioBuffer<float> &buffer, int numChannels, const Routing &routing,
+                          float feedbackStart, float feedbackStep, float mixStart, float mixStep);
+
+    // Contiguous copies into and out of the ring, split at the wrap point
+    void readRing(int channel, int startPosition, float *destination, int numSamples) const;
+    void writeRing(int channel, int startPosition, const float *source, int numSamples);
+
     // Utility functions
-    float calculateDelaySamples() const;
-    int getReadPosition(int writePosition, float delaySamples) const;
-    float getInterpolatedSample(const float *bufferData, int bufferSize, float readPos) const;
+    float calculateDelaySamples(float delayTimeSeconds) const;
+
+    // Delay time in seconds for this block, from either the free time or the synced note
+    float getEffectiveDelayTime() const;
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(DelayProcessor)
 };
\ No newline at end of file
@@ -0,0 +1,154 @@
+#pragma once
+
+#include <JuceHeader.h>
+
+// Block kernels for each DistortionAlgorithm.
+//
+// Every shaper is a small functor whose per-block constants are computed once in
+// the constructor. The per-sample operator() is branchless, so applying it over a
+// contiguous buffer compiles to SSE/AVX/NEON code, and the algorithm switch runs
+// once per block instead of once per sample.
+namespace DistortionKernels
+{
+    // exp(x) for x <= 0, built from a 2^x split into exponent bits and a polynomial
+    // for the fraction. Rounding to the nearest exponent keeps the fraction within
+    // [-0.5, 0.5], where the polynomial's relative error stays below 1e-5.
+    inline float fastExpNegative(float x)
+    {
+        const float y = juce::jmax(x * 1.44269504f, -126.0f); // log2(e)
+        const float shifted = y + 0.5f;
+        int whole = static_cast<int>(shifted);
+        whole -= static_cast<float>(whole) > shifted ? 1 : 0; // floor for negative inputs
+        const float f = y - static_cast<float>(whole);
+
+        // 2^f on [-0.5, 0.5]
+        const float p = 1.0f + f * (0.69314718f + f * (0.24022651f + f * (0.05550411f + f * (0.00961813f + f * 0.00133336f))));
+
+        const juce::int32 bits = (whole + 127) << 23;
+        float scale;
+        std::memcpy(&scale, &bits, sizeof(float));
+        return p * scale;
+    }
+
+    // tanh via JUCE's rational approximation, clamped to its valid input range
+    inline float fastTanh(float x)
+    {
+        const float clamped = juce::jlimit(-5.0f, 5.0f, x);
+        return juce::jlimit(-1.0f, 1.0f, juce::dsp::FastMathApproximations::tanh(clamped));
+    }
+
+    struct SoftClip
+    {
+        explicit SoftClip(float drive) : gain(1.0f + drive * 3.0f) {}
+
+        float operator()(float sample) const { return fastTanh(sample * gain); }
+
+        float gain;
+    };
+
+    struct HardClip
+    {
+        explicit HardClip(float drive) : gain(1.0f + drive * 5.0f), threshold(1.0f - drive * 0.9f) {}
+
+        float operator()(float sample) const { return juce::jlimit(-threshold, threshold, sample * gain); }
+
+        float gain, threshold;
+    };
+
+    struct Foldback
+    {
+        explicit Foldback(float drive)
+            : gain(1.0f + drive * 3.0f), threshold(1.0f / gain), inverseThreshold(gain) {}
+
+        float operator()(float sample) const
+        {
+            const float driven = sample * gain;
+            const float magnitude = std::abs(driven);
+
+            // Number of times the signal has crossed the threshold and the remainder past it.
+            // Clamped first so a runaway input (or NaN) never overflows the int conversion.
+            const int foldCount = static_cast<int>(juce::jmin(1.0e6f, magnitude * inverseThreshold));
+            const float remainder = magnitude - threshold * static_cast<float>(foldCount);
+
+            // Even folds keep the sign of the input, odd folds reflect back from the threshold
+            const float even = driven < 0.0f ? -remainder : remainder;
+            const float odd = threshold - remainder;
+            return (foldCount & 1) ? odd : even;
+        }
+
+        float gain, threshold, inverseThreshold;
+    };
+
+    struct Waveshaper
+    {
+        explicit Waveshaper(float drive) : gain(1.0f + drive * 5.0f), curve(drive * 3.0f + 1.0f) {}
+
+        float operator()(float sample) const
+        {
+            const float driven = sample * gain;
+            const float shaped = 1.0f - fastExpNegative(-std::abs(driven) * curve);
+            return driven > 0.0f ? shaped : -shaped;
+        }
+
+        float gain, curve;
+    };
+
+    struct Bitcrusher
+    {
+        explicit Bitcrusher(float drive) : gain(1.0f + drive * 3.0f)
+        {
+            // Between 2 and 16 bits, resolved once per block rather than per sample
+            const int bits = juce::jlimit(2, 16, static_cast<int>(16.0f - drive * 14.0f));
+            steps = static_cast<float>(1 << bits);
+            inverseSteps = 1.0f / steps;
+        }
+
+        float operator()(float sample) const
+        {
+            // Clamped so a runaway input (or NaN) never overflows the int conversion below
+            const float scaled = juce::jmax(-1.0e6f, juce::jmin(1.0e6f, sample * gain * steps));
+
+            // Branchless floor
+            float truncated = static_cast<float>(static_cast<int>(scaled));
+            truncated -= truncated > scaled ? 1.0f : 0.0f;
+            return truncated * inverseSteps;
+        }
+
+        float gain, steps, inverseSteps;
+    };
+
+    // Fused stage applied in place over a contiguous block:
+    //   out = shaper(in * inputGain) * wetGain + in * dryGain
+    // Each sample is read once and written once, and the dry value never leaves a register.
+    template <typename Shaper>
+    inline void process(float *JUCE_RESTRICT data, int numSamples, const Shaper &shaper,
+                        float inputGain, float wetGain, float dryGain)
+    {
+        for (int sample = 0; sample < numSamples; ++sample)
+        {
+            const float dry = data[sample];
+            data[sample] = shaper(dry * inputGain) * wetGain + dry * dryGain;
+        }
+    }
+
+    // Same stage with each gain ramping linearly from its start value to its end value
+    // across the block. Used only while a parameter is being smoothed.
+    template <typename Shaper>
+    inline void processRamped(float *JUCE_RESTRICT data, int numSamples, const Shaper &shaper,
+                              float inputStart, float inputEnd, float wetStart, float wetEnd,
+                              float dryStart, float dryEnd)
+    {
+        const float scale = 1.0f / static_cast<float>(numSamples);
+        const float inputStep = (inputEnd - inputStart) * scale;
+        const float wetStep = (wetEnd - wetStart) * scale;
+        const float dryStep = (dryEnd - dryStart) * scale;
+
+        for (int sample = 0; sample < numSamples; ++sample)
+        {
+            const float position = static_cast<float>(sample);
+            const float dry = data[sample];
+            data[sample] = shaper(dry * (inputStart + inputStep * position)) * (wetStart + wetStep * position) +
+                           dry * (dryStart + dryStep * position);
+        }
+    }
+}
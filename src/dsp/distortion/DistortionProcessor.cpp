@@ -1,4 +1,38 @@
 #include "DistortionProcessor.h"
+#include "DistortionKernels.h"
+
+namespace
+{
+    // Builds the shaper for an algorithm and hands it to a generic kernel call, so the
+    // algorithm switch runs once per call rather than once per sample
+    template <typename Function>
+    void withShaper(DistortionAlgorithm algorithm, float driveAmount, Function &&function)
+    {
+        switch (algorithm)
+        {
+        case DistortionAlgorithm::HardClip:
+            function(DistortionKernels::HardClip(driveAmount));
+            break;
+
+        case DistortionAlgorithm::Foldback:
+            function(DistortionKernels::Foldback(driveAmount));
+            break;
+
+        case DistortionAlgorithm::Waveshaper:
+            function(DistortionKernels::Waveshaper(driveAmount));
+            break;
+
+        case DistortionAlgorithm::Bitcrusher:
+            function(DistortionKernels::Bitcrusher(driveAmount));
+            break;
+
+        case DistortionAlgorithm::SoftClip:
+        default:
+            function(DistortionKernels::SoftClip(driveAmount));
+            break;
+        }
+    }
+}
 
 DistortionProcessor::DistortionProcessor()
     : drive(0.5f), mix(0.5f), inputGain(0.0f), outputGain(0.0f),
@@ -7,167 +41,180 @@ DistortionProcessor::DistortionProcessor()
 {
 }
 
-void DistortionProcessor::prepare(double sampleRate)
+void DistortionProcessor::prepare(double sampleRate, int maxBlockSize)
 {
-    // Initialize any algorithm-specific setup here if needed
+    // Build one oversampling chain per factor (2x, 4x, 8x). The half-band filters are
+    // linear-phase FIR, so the dry path needs nothing more than the integer latency as a
+    // plain delay for any mix below 1 to line up without combing. Polyphase IIR would be
+    // cheaper, but its phase shift varies with frequency and no integer delay matches it.
+    int maxLatency = 0;
+    for (size_t i = 0; i < oversamplers.size(); ++i)
+    {
+        auto oversampler = std::make_unique<juce::dsp::Oversampling<float>>(
+            2, i + 1, juce::dsp::Oversampling<float>::filterHalfBandFIREquiripple, false, true);
+        oversampler->initProcessing(static_cast<size_t>(maxBlockSize));
+        const int latency = static_cast<int>(oversampler->getLatencyInSamples());
+        latencyByFactor[i + 1] = latency;
+        maxLatency = juce::jmax(maxLatency, latency);
+        oversamplers[i] = std::move(oversampler);
+    }
+
+    // Dry path delay sized for the worst case factor
+    dryDelay.setMaximumDelayInSamples(maxLatency + 1);
+    dryDelay.prepare({sampleRate, static_cast<juce::uint32>(maxBlockSize), 2});
+
+    // 20ms ramps are short enough to feel immediate and long enough to hide steps
+    driveSmoother.reset(sampleRate, 0.02);
+    inputGainSmoother.reset(sampleRate, 0.02);
+    wetGainSmoother.reset(sampleRate, 0.02);
+    dryGainSmoother.reset(sampleRate, 0.02);
+
+    const float mixAmount = mix.load();
+    driveSmoother.setCurrentAndTargetValue(drive.load());
+    inputGainSmoother.setCurrentAndTargetValue(inputGainLinear.load());
+    wetGainSmoother.setCurrentAndTargetValue(mixAmount * outputGainLinear.load());
+    dryGainSmoother.setCurrentAndTargetValue((1.0f - mixAmount) * outputGainLinear.load());
+
+    // Start from a clean state with the requested factor
+    activeOversampling = -1;
+    applyOversamplingChange();
 }
 
-void DistortionProcessor::processBlock(juce::AudioBuffer<float> &buffer)
+void DistortionProcessor::processBlock(juce::AudioBuffer<float> &buffer, ScratchArena &scratch)
 {
-    const int numChannels = buffer.getNumChannels();
+    const int numChannels = juce::jmin(buffer.getNumChannels(), 2);
     const int numSamples = buffer.getNumSamples();
 
-    // Create a dry buffer for the mix
-    juce::AudioBuffer<float> dryBuffer;
-    dryBuffer.makeCopyOf(buffer);
+    if (numSamples == 0)
+        return;
 
-    // Apply input gain
-    if (inputGainLinear != 1.0f)
-    {
-        for (int channel = 0; channel < numChannels; ++channel)
-        {
-            float *channelData = buffer.getWritePointer(channel);
+    // Pick up a quality change requested from the message thread
+    if (requestedOversampling.load() != activeOversampling)
+        applyOversamplingChange();
 
-            for (int sample = 0; sample < numSamples; ++sample)
-            {
-                channelData[sample] *= inputGainLinear;
-            }
-        }
-    }
+    // Snapshot the parameters once so the whole block sees a consistent state
+    const DistortionAlgorithm algorithm = currentAlgorithm.load();
+    const float mixAmount = mix.load();
+    const float outputGainAmount = outputGainLinear.load();
 
-    // Apply distortion
-    for (int channel = 0; channel < numChannels; ++channel)
-    {
-        float *channelData = buffer.getWritePointer(channel);
+    // Wet/dry mix and output gain collapse into two scalar gains
+    driveSmoother.setTargetValue(drive.load());
+    inputGainSmoother.setTargetValue(inputGainLinear.load());
+    wetGainSmoother.setTargetValue(mixAmount * outputGainAmount);
+    dryGainSmoother.setTargetValue((1.0f - mixAmount) * outputGainAmount);
 
-        for (int sample = 0; sample < numSamples; ++sample)
-        {
-            channelData[sample] = distort(channelData[sample]);
-        }
-    }
+    // Smoothed values at the edges of this block; identical when nothing is moving
+    const StageGains start{driveSmoother.getCurrentValue(), inputGainSmoother.getCurrentValue(),
+                           wetGainSmoother.getCurrentValue(), dryGainSmoother.getCurrentValue()};
+    const StageGains end{driveSmoother.skip(numSamples), inputGainSmoother.skip(numSamples),
+                         wetGainSmoother.skip(numSamples), dryGainSmoother.skip(numSamples)};
 
-    // Apply wet/dry mix
-    if (mix < 1.0f)
-    {
-        for (int channel = 0; channel < numChannels; ++channel)
-        {
-            float *wetData = buffer.getWritePointer(channel);
-            const float *dryData = dryBuffer.getReadPointer(channel);
-
-            for (int sample = 0; sample < numSamples; ++sample)
-            {
-                wetData[sample] = wetData[sample] * mix + dryData[sample] * (1.0f - mix);
-            }
-        }
-    }
+    auto *oversampler = getOversampler(activeOversampling);
 
-    // Apply output gain
-    if (outputGainLinear != 1.0f)
+    if (oversampler == nullptr)
     {
+        // Single fused pass per channel: input gain, shaper, mix and output gain,
+        // reading and writing each sample exactly once
         for (int channel = 0; channel < numChannels; ++channel)
-        {
-            float *channelData = buffer.getWritePointer(channel);
+            distortBlock(algorithm, buffer.getWritePointer(channel), numSamples, start, end);
 
-            for (int sample = 0; sample < numSamples; ++sample)
-            {
-                channelData[sample] *= outputGainLinear;
-            }
-        }
+        return;
     }
-}
 
-float DistortionProcessor::distort(float sample)
-{
-    // Route to the appropriate algorithm implementation
-    switch (currentAlgorithm)
-    {
-    case DistortionAlgorithm::SoftClip:
-        return softClip(sample);
+    // Oversampled path: the resampling filters need a separate dry copy,
+    // but input gain is still folded into the shaper pass at the higher rate
+    auto &dryBuffer = scratch.copyOf(buffer);
 
-    case DistortionAlgorithm::HardClip:
-        return hardClip(sample);
+    juce::dsp::AudioBlock<float> block(buffer.getArrayOfWritePointers(), static_cast<size_t>(numChannels),
+                                       static_cast<size_t>(numSamples));
+    auto oversampledBlock = oversampler->processSamplesUp(block);
 
-    case DistortionAlgorithm::Foldback:
-        return foldback(sample);
+    const StageGains wetOnlyStart{start.drive, start.input, 1.0f, 0.0f};
+    const StageGains wetOnlyEnd{end.drive, end.input, 1.0f, 0.0f};
+    for (size_t channel = 0; channel < oversampledBlock.getNumChannels(); ++channel)
+        distortBlock(algorithm, oversampledBlock.getChannelPointer(channel),
+                     static_cast<int>(oversampledBlock.getNumSamples()), wetOnlyStart, wetOnlyEnd);
 
-    case DistortionAlgorithm::Waveshaper:
-        return waveshaper(sample);
+    oversampler->processSamplesDown(block);
 
-    case DistortionAlgorithm::Bitcrusher:
-        return bitcrusher(sample);
+    // Single pass that delays the dry signal to match the filters and applies mix and output gain
+    const float wetStep = (end.wet - start.wet) / static_cast<float>(numSamples);
+    const float dryStep = (end.dry - start.dry) / static_cast<float>(numSamples);
 
-    default:
-        return softClip(sample);
-    }
-}
+    for (int channel = 0; channel < numChannels; ++channel)
+    {
+        float *wetData = buffer.getWritePointer(channel);
+        const float *dryData = dryBuffer.getReadPointer(channel);
 
-float DistortionProcessor::softClip(float sample)
-{
-    float driven = sample * (1.0f + drive * 3.0f);
-    return std::tanh(driven);
+        for (int sample = 0; sample < numSamples; ++sample)
+        {
+            const float position = static_cast<float>(sample);
+            dryDelay.pushSample(channel, dryData[sample]);
+            wetData[sample] = wetData[sample] * (start.wet + wetStep * position) +
+                              dryDelay.popSample(channel) * (start.dry + dryStep * position);
+        }
+    }
 }
 
-float DistortionProcessor::hardClip(float sample)
+void DistortionProcessor::distortBlock(DistortionAlgorithm algorithm, float *data, int numSamples,
+                                       const StageGains &start, const StageGains &end)
 {
-    float threshold = 1.0f - drive * 0.9f;
-    float driven = sample * (1.0f + drive * 5.0f);
-
-    // Hard clipping at threshold
-    if (driven > threshold)
-        return threshold;
-    else if (driven < -threshold)
-        return -threshold;
-    else
-        return driven;
-}
+    // Steady parameters: one fused pass with constant gains
+    if (start.drive == end.drive && start.input == end.input && start.wet == end.wet && start.dry == end.dry)
+    {
+        withShaper(algorithm, start.drive, [&](const auto &shaper)
+                   { DistortionKernels::process(data, numSamples, shaper, start.input, start.wet, start.dry); });
+        return;
+    }
 
-float DistortionProcessor::foldback(float sample)
-{
-    // Adjust threshold based on drive (lower drive = higher threshold)
-    float threshold = 1.0f / (1.0f + drive * 3.0f);
-    float driven = sample * (1.0f + drive * 3.0f);
+    // Ramping: gains are interpolated per sample, and the shaper constants are
+    // rebuilt for each control-rate segment from the drive at its midpoint
+    const float scale = 1.0f / static_cast<float>(numSamples);
+    auto interpolate = [scale](float from, float to, int position)
+    {
+        return from + (to - from) * static_cast<float>(position) * scale;
+    };
 
-    // Foldback algorithm
-    if (driven > threshold || driven < -threshold)
+    for (int offset = 0; offset < numSamples; offset += BlockSmoother::controlInterval)
     {
-        // Get the number of times the signal has crossed the threshold
-        float foldCount = std::floor(std::abs(driven) / threshold);
-        // Apply folding
-        if (static_cast<int>(foldCount) % 2 == 0)
-            return driven - threshold * foldCount * (driven > 0 ? 1 : -1);
-        else
-            return threshold * (foldCount + 1) - driven * (driven > 0 ? 1 : -1);
+        const int length = juce::jmin(BlockSmoother::controlInterval, numSamples - offset);
+        const int segmentEnd = offset + length;
+        const float driveAmount = interpolate(start.drive, end.drive, offset + length / 2);
+
+        withShaper(algorithm, driveAmount, [&](const auto &shaper)
+                   { DistortionKernels::processRamped(data + offset, length, shaper,
+                                                      interpolate(start.input, end.input, offset),
+                                                      interpolate(start.input, end.input, segmentEnd),
+                                                      interpolate(start.wet, end.wet, offset),
+                                                      interpolate(start.wet, end.wet, segmentEnd),
+                                                      interpolate(start.dry, end.dry, offset),
+                                                      interpolate(start.dry, end.dry, segmentEnd)); });
     }
-
-    return driven;
 }
 
-float DistortionProcessor::waveshaper(float sample)
+juce::dsp::Oversampling<float> *DistortionProcessor::getOversampler(int factorIndex) const
 {
-    float driven = sample * (1.0f + drive * 5.0f);
+    // Index 0 is 1x, which runs without an oversampler
+    if (factorIndex <= 0 || factorIndex > static_cast<int>(oversamplers.size()))
+        return nullptr;
 
-    // Custom waveshaping curve (polynomial approximation)
-    // This creates more complex harmonic distortion
-    float x = driven;
-    float absX = std::abs(x);
-    float sign = x > 0 ? 1.0f : -1.0f;
-
-    return sign * (1.0f - std::exp(-absX * (drive * 3.0f + 1.0f)));
+    return oversamplers[static_cast<size_t>(factorIndex - 1)].get();
 }
 
-float DistortionProcessor::bitcrusher(float sample)
+void DistortionProcessor::applyOversamplingChange()
 {
-    float driven = sample * (1.0f + drive * 3.0f);
-
-    // Calculate bit reduction amount
-    int bits = static_cast<int>(16.0f - drive * 14.0f); // Between 2 and 16 bits
-    bits = juce::jlimit(2, 16, bits);
+    activeOversampling = requestedOversampling.load();
 
-    // Calculate step size for the given bit depth
-    float steps = std::pow(2.0f, static_cast<float>(bits));
+    // Clear the filter history so the new chain starts silent
+    dryDelaySamples = 0;
+    if (auto *oversampler = getOversampler(activeOversampling))
+    {
+        oversampler->reset();
+        dryDelaySamples = static_cast<int>(oversampler->getLatencyInSamples());
+    }
 
-    // Quantize the signal
-    return std::floor(driven * steps) / steps;
+    dryDelay.reset();
+    dryDelay.setDelay(static_cast<float>(dryDelaySamples));
 }
 
 void DistortionProcessor::setDrive(float newDrive)
@@ -190,6 +237,11 @@ float DistortionProcessor::getMix() const
     return mix;
 }
 
+void DistortionProcessor::setAlgorithm(DistortionAlgorithm newAlgorithm)
+{
+    currentAlgorithm = newAlgorithm;
+}
+
 void DistortionProcessor::setAlgorithm(const juce::String &algorithmName)
 {
     // Convert string to enum
@@ -210,12 +262,17 @@ void DistortionProcessor::setAlgorithm(const juce::String &algorithmName)
 
 DistortionAlgorithm DistortionProcessor::getAlgorithm() const
 {
-    return currentAlgorithm;
+    return currentAlgorithm.load();
+}
+
+juce::StringArray DistortionProcessor::getAlgorithmNames()
+{
+    return {"soft_clip", "hard_clip", "foldback", "waveshaper", "bitcrusher"};
 }
 
 juce::String DistortionProcessor::getAlgorithmName() const
 {
-    switch (currentAlgorithm)
+    switch (currentAlgorithm.load())
     {
     case DistortionAlgorithm::SoftClip:
         return "soft_clip";
@@ -254,6 +311,64 @@ float DistortionProcessor::getOutputGain() const
     return outputGain;
 }
 
+void DistortionProcessor::setOversampling(OversamplingFactor newFactor)
+{
+    requestedOversampling.store(static_cast<int>(newFactor));
+}
+
+void DistortionProcessor::setOversampling(const juce::String &factorName)
+{
+    if (factorName == "2x")
+        setOversampling(OversamplingFactor::x2);
+    else if (factorName == "4x")
+        setOversampling(OversamplingFactor::x4);
+    else if (factorName == "8x")
+        setOversampling(OversamplingFactor::x8);
+    else
+        setOversampling(OversamplingFactor::x1); // Fallback to no oversampling
+}
+
+OversamplingFactor DistortionProcessor::getOversampling() const
+{
+    return static_cast<OversamplingFactor>(requestedOversampling.load());
+}
+
+juce::String DistortionProcessor::getOversamplingName() const
+{
+    switch (getOversampling())
+    {
+    case OversamplingFactor::x2:
+        return "2x";
+    case OversamplingFactor::x4:
+        return "4x";
+    case OversamplingFactor::x8:
+        return "8x";
+    default:
+        return "1x";
+    }
+}
+
+juce::StringArray DistortionProcessor::getOversamplingNames()
+{
+    return {"1x", "2x", "4x", "8x"};
+}
+
+int DistortionProcessor::getLatencySamples() const
+{
+    // Report the latency of the requested factor so the host can compensate right away
+    return getLatencySamples(getOversampling());
+}
+
+int DistortionProcessor::getLatencySamples(OversamplingFactor factor) const
+{
+    // Only the cached values are read, never the oversamplers prepare() may be rebuilding
+    const int factorIndex = static_cast<int>(factor);
+    if (!juce::isPositiveAndBelow(factorIndex, static_cast<int>(latencyByFactor.size())))
+        return 0;
+
+    return latencyByFactor[static_cast<size_t>(factorIndex)];
+}
+
 float DistortionProcessor::dbToGain(float gainInDb)
 {
     return std::pow(10.0f, gainInDb / 20.0f);
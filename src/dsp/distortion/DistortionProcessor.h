@@ -1,6 +1,8 @@
 #pragma once
 
 #include <JuceHeader.h>
+#include "ScratchArena.h"
+#include "BlockSmoother.h"
 
 enum class DistortionAlgorithm
 {
@@ -11,14 +13,22 @@ enum class DistortionAlgorithm
     Bitcrusher
 };
 
+enum class OversamplingFactor
+{
+    x1, // No oversampling (default, zero latency)
+    x2,
+    x4,
+    x8
+};
+
 class DistortionProcessor
 {
 public:
     DistortionProcessor();
 
-    void prepare(double sampleRate);
+    void prepare(double sampleRate, int maxBlockSize);
 
-    void processBlock(juce::AudioBuffer<float> &buffer);
+    void processBlock(juce::AudioBuffer<float> &buffer, ScratchArena &scratch);
 
     void setDrive(float newDrive);
     float getDrive() const;
@@ -26,10 +36,14 @@ public:
     void setMix(float newMix);
     float getMix() const;
 
+    void setAlgorithm(DistortionAlgorithm newAlgorithm);
     void setAlgorithm(const juce::String &algorithmName);
     DistortionAlgorithm getAlgorithm() const;
     juce::String getAlgorithmName() const;
 
+    // Algorithm identifiers in enum order, used for choice parameters and the UI
+    static juce::StringArray getAlgorithmNames();
+
     // Input and output gain in dB (-12 to +12)
     void setInputGain(float gainInDb);
     float getInputGain() const;
@@ -37,23 +51,63 @@ public:
     void setOutputGain(float gainInDb);
     float getOutputGain() const;
 
+    // Oversampling around the nonlinearity (1x, 2x, 4x or 8x)
+    void setOversampling(OversamplingFactor newFactor);
+    void setOversampling(const juce::String &factorName);
+    OversamplingFactor getOversampling() const;
+    juce::String getOversamplingName() const;
+    static juce::StringArray getOversamplingNames();
+
+    // Latency added by the selected oversampling factor, in host-rate samples
+    int getLatencySamples() const;
+
+    // Latency a given factor adds, whether or not it is selected. Safe to call from any
+    // thread, including while prepare() runs; 0 until the first prepare().
+    int getLatencySamples(OversamplingFactor factor) const;
+
 private:
-    float drive;      // Distortion amount (0.0 - 1.0)
-    float mix;        // Wet/dry mix (0.0 - 1.0)
-    float inputGain;  // Input gain in dB (-12 to +12)
-    float outputGain; // Output gain in dB (-12 to +12)
-
-    float inputGainLinear;
-    float outputGainLinear;
-
-    DistortionAlgorithm currentAlgorithm;
-
-    float distort(float sample);
-    float softClip(float sample);
-    float hardClip(float sample);
-    float foldback(float sample);
-    float waveshaper(float sample);
-    float bitcrusher(float sample);
+    // Parameters are atomics so the UI can read them while the audio thread runs.
+    // processBlock takes one snapshot per block.
+    std::atomic<float> drive;      // Distortion amount (0.0 - 1.0)
+    std::atomic<float> mix;        // Wet/dry mix (0.0 - 1.0)
+    std::atomic<float> inputGain;  // Input gain in dB (-12 to +12)
+    std::atomic<float> outputGain; // Output gain in dB (-12 to +12)
+
+    std::atomic<float> inputGainLinear;
+    std::atomic<float> outputGainLinear;
+
+    std::atomic<DistortionAlgorithm> currentAlgorithm;
+
+    // Per-block ramps towards the parameter snapshot. Mix and output gain are smoothed
+    // as the combined wet and dry gains the fused kernel actually uses.
+    BlockSmoother driveSmoother;
+    BlockSmoother inputGainSmoother;
+    BlockSmoother wetGainSmoother;
+    BlockSmoother dryGainSmoother;
+
+    // Smoothed values at one edge of a block
+    struct StageGains
+    {
+        float drive, input, wet, dry;
+    };
+
+    // Oversampling state. One linear-phase half-band chain per factor is built in
+    // prepare() so switching quality never allocates on the audio thread.
+    std::atomic<int> requestedOversampling{0};
+    int activeOversampling = 0;
+    std::array<std::unique_ptr<juce::dsp::Oversampling<float>>, 3> oversamplers;
+
+    // Latency of each factor in host-rate samples, filled in by prepare(); index 0 is 1x
+    std::array<std::atomic<int>, 4> latencyByFactor{};
+
+    // Delays the dry signal by the oversampling latency so the mix stays phase aligned
+    juce::dsp::DelayLine<float, juce::dsp::DelayLineInterpolationTypes::None> dryDelay;
+    int dryDelaySamples = 0;
+
+    juce::dsp::Oversampling<float> *getOversampler(int factorIndex) const;
+    void applyOversamplingChange();
+    static void distortBlock(DistortionAlgorithm algorithm, float *data, int numSamples,
+                             const StageGains &start, const StageGains &end);
 
     float dbToGain(float gainInDb);
 
@@ -1,12 +1,14 @@
 #include "FilterProcessor.h"
-#include <complex>
 
 FilterProcessor::FilterProcessor()
     : frequency(1000.0f),              // 1kHz default frequency
       filterType(FilterType::LowPass), // Default to low pass
       resonance(0.7f),                 // Default resonance
       currentSampleRate(44100.0),
-      bufferSize(0)
+      bufferSize(0),
+      appliedFrequency(1000.0f),
+      appliedFilterType(FilterType::LowPass),
+      appliedResonance(0.7f)
 {
 }
 
@@ -15,90 +17,125 @@ void FilterProcessor::prepare(double sampleRate, int maxBlockSize)
     currentSampleRate = sampleRate;
     bufferSize = maxBlockSize;
 
-    // Clear and resize filter objects
-    filters.clear();
-
     // Create filters for stereo processing (2 channels)
-    for (int i = 0; i < 2; ++i)
-    {
-        auto filter = std::make_unique<juce::IIRFilter>();
-        filters.push_back(std::move(filter));
-    }
+    filters.assign(2, StateVariableFilter());
+
+    frequencySmoother.reset(sampleRate, 0.02);
+    resonanceSmoother.reset(sampleRate, 0.02);
+    frequencySmoother.setCurrentAndTargetValue(frequency.load());
+    resonanceSmoother.setCurrentAndTargetValue(resonance.load());
 
     // Initialize filter coefficients
-    updateFilters();
+    updateFilters(frequency.load(), filterType.load(), resonance.load());
 }
 
 void FilterProcessor::processBlock(juce::AudioBuffer<float> &buffer)
 {
-    const int numChannels = buffer.getNumChannels();
     const int numSamples = buffer.getNumSamples();
 
     // Early return if we haven't been prepared yet
     if (filters.empty())
         return;
 
-    // Process each channel
-    for (int channel = 0; channel < numChannels && channel < filters.size(); ++channel)
+    // Snapshot the parameters once per block and only rebuild coefficients when they
+    // changed, so the setters never touch filter state from another thread
+    const FilterType typeValue = filterType.load();
+    frequencySmoother.setTargetValue(frequency.load());
+    resonanceSmoother.setTargetValue(resonance.load());
+
+    if (!frequencySmoother.isSmoothing() && !resonanceSmoother.isSmoothing())
     {
-        float *channelData = buffer.getWritePointer(channel);
-        auto &filter = filters[channel];
+        const float frequencyValue = frequencySmoother.getCurrentValue();
+        const float resonanceValue = resonanceSmoother.getCurrentValue();
+
+        if (frequencyValue != appliedFrequency || typeValue != appliedFilterType || resonanceValue != appliedResonance)
+            updateFilters(frequencyValue, typeValue, resonanceValue);
 
-        // Process the samples through the filter
-        filter->processSamples(channelData, numSamples);
+        processChannels(buffer, 0, numSamples, typeValue, coefficients, coefficients);
+        return;
     }
-}
 
-void FilterProcessor::reset()
-{
-    for (auto &filter : filters)
+    // While cutoff or resonance is moving, the exact coefficients are computed every
+    // control interval and interpolated per sample in between
+    for (int offset = 0; offset < numSamples; offset += BlockSmoother::controlInterval)
     {
-        filter->reset();
+        const int length = juce::jmin(BlockSmoother::controlInterval, numSamples - offset);
+        const auto from = coefficients;
+        updateFilters(frequencySmoother.skip(length), typeValue, resonanceSmoother.skip(length));
+
+        processChannels(buffer, offset, length, typeValue, from, coefficients);
     }
 }
 
-void FilterProcessor::updateFilters()
+void FilterProcessor::processChannels(juce::AudioBuffer<float> &buffer, int startSample, int numSamples, FilterType type,
+                                      const StateVariableFilter::Coefficients &from,
+                                      const StateVariableFilter::Coefficients &to)
 {
-    // Ensure the filter is within valid range
-    float safeFreq = juce::jlimit(20.0f, 20000.0f, frequency);
-    float safeRes = juce::jlimit(0.1f, 10.0f, resonance);
+    const int numChannels = juce::jmin(buffer.getNumChannels(), static_cast<int>(filters.size()));
+    const bool ramped = from.k != to.k || from.a1 != to.a1 || from.a2 != to.a2 || from.a3 != to.a3;
+
+    // The output tap is a template argument, so the type switch runs once per call
+    auto run = [&](auto typeTag)
+    {
+        constexpr FilterType selectedType = decltype(typeTag)::value;
+
+        for (int channel = 0; channel < numChannels; ++channel)
+        {
+            float *channelData = buffer.getWritePointer(channel, startSample);
 
-    // Create appropriate coefficients based on filter type
-    juce::IIRCoefficients coeffs;
+            if (ramped)
+                filters[channel].processRamped<selectedType>(channelData, numSamples, from, to);
+            else
+                filters[channel].process<selectedType>(channelData, numSamples, to);
+        }
+    };
 
-    switch (filterType)
+    switch (type)
     {
-    case FilterType::LowPass:
-        coeffs = juce::IIRCoefficients::makeLowPass(currentSampleRate, safeFreq, safeRes);
-        break;
     case FilterType::BandPass:
-        coeffs = juce::IIRCoefficients::makeBandPass(currentSampleRate, safeFreq, safeRes);
+        run(std::integral_constant<FilterType, FilterType::BandPass>());
         break;
     case FilterType::HighPass:
-        coeffs = juce::IIRCoefficients::makeHighPass(currentSampleRate, safeFreq, safeRes);
+        run(std::integral_constant<FilterType, FilterType::HighPass>());
         break;
+    case FilterType::LowPass:
     default:
-        coeffs = juce::IIRCoefficients::makeLowPass(currentSampleRate, safeFreq, safeRes);
+        run(std::integral_constant<FilterType, FilterType::LowPass>());
         break;
     }
+}
 
-    // Apply coefficients to all filters
+void FilterProcessor::reset()
+{
     for (auto &filter : filters)
     {
-        filter->setCoefficients(coeffs);
+        filter.reset();
     }
 }
 
+void FilterProcessor::updateFilters(float newFrequency, FilterType newType, float newResonance)
+{
+    appliedFrequency = newFrequency;
+    appliedFilterType = newType;
+    appliedResonance = newResonance;
+
+    // Ensure the filter is within valid range
+    float safeFreq = juce::jlimit(20.0f, 20000.0f, newFrequency);
+    float safeRes = juce::jlimit(0.1f, 10.0f, newResonance);
+
+    // The state-variable filter shares one set of coefficients across all three
+    // outputs, so the type only selects which output processBlock reads
+    coefficients = StateVariableFilter::Coefficients::make(currentSampleRate.load(), safeFreq, safeRes);
+}
+
 void FilterProcessor::setFrequency(float newFrequency)
 {
     frequency = juce::jlimit(20.0f, 20000.0f, newFrequency);
-    updateFilters();
 }
 
 void FilterProcessor::setFilterType(FilterType newType)
 {
     filterType = newType;
-    updateFilters();
 }
 
 void FilterProcessor::setFilterType(const juce::String &typeName)
@@ -111,14 +148,11 @@ void FilterProcessor::setFilterType(const juce::String &typeName)
         filterType = FilterType::HighPass;
     else
         filterType = FilterType::LowPass; // Default to lowpass for unknown types
-
-    updateFilters();
 }
 
 void FilterProcessor::setResonance(float newResonance)
 {
     resonance = juce::jlimit(0.1f, 10.0f, newResonance);
-    updateFilters();
 }
 
 float FilterProcessor::getFrequency() const
@@ -128,12 +162,17 @@ float FilterProcessor::getFrequency() const
 
 FilterType FilterProcessor::getFilterType() const
 {
-    return filterType;
+    return filterType.load();
+}
+
+juce::StringArray FilterProcessor::getFilterTypeNames()
+{
+    return {"lowpass", "bandpass", "highpass"};
 }
 
 juce::String FilterProcessor::getFilterTypeName() const
 {
-    switch (filterType)
+    switch (filterType.load())
     {
     case FilterType::LowPass:
         return "lowpass";
@@ -151,55 +190,77 @@ float FilterProcessor::getResonance() const
     return resonance;
 }
 
-void FilterProcessor::getMagnitudeResponse(double *frequencies, double *magnitudes, int numPoints)
+const std::array<float, FilterProcessor::responseSize> &FilterProcessor::getMagnitudeResponse(float newFrequency, FilterType newType,
+                                                                                             float newResonance)
 {
-    // Early return if filters are not initialized
-    if (filters.empty())
-        return;
+    const double sampleRate = currentSampleRate.load();
+    const double nyquistLimit = sampleRate * 0.49;
 
-    // Calculate the magnitude response at each frequency point
-    for (int i = 0; i < numPoints; ++i)
+    // The frequency grid only changes with the sample rate
+    if (sampleRate != responseSampleRate)
     {
-        // Log scale from 20Hz to 20kHz
-        double freqHz = 20.0 * std::pow(1000.0, i / (double)(numPoints - 1));
-        frequencies[i] = freqHz;
+        responseSampleRate = sampleRate;
+        responseFrequency = -1.0f;
+
+        for (int i = 0; i < responseSize; ++i)
+        {
+            // Log scale from 20Hz to 20kHz
+            const double freqHz = 20.0 * std::pow(1000.0, i / static_cast<double>(responseSize - 1));
+            responsePrewarped[i] = static_cast<float>(
+                std::tan(juce::MathConstants<double>::pi * juce::jmin(freqHz, nyquistLimit) / sampleRate));
+        }
+    }
+
+    const float frequencyValue = juce::jlimit(20.0f, 20000.0f, newFrequency);
+    const float resonanceValue = juce::jlimit(0.1f, 10.0f, newResonance);
+    const FilterType typeValue = newType;
+
+    if (frequencyValue == responseFrequency && resonanceValue == responseResonance && typeValue == responseType)
+        return responseMagnitudes;
 
-        // Normalized frequency (0 to π)
-        double normalizedFreq = (2.0 * juce::MathConstants<double>::pi * freqHz) / currentSampleRate;
+    responseFrequency = frequencyValue;
+    responseResonance = resonanceValue;
+    responseType = typeValue;
 
-        // Calculate magnitude response manually based on the filter type
-        double magnitude = 0.0;
+    // The TPT filter is the bilinear transform of the analog state-variable filter with
+    // the cutoff prewarped, so the digital response at w is the analog one at
+    // x = tan(w / 2) / g:  |H| = N(x) / sqrt((1 - x^2)^2 + (k x)^2)
+    const float g = static_cast<float>(
+        std::tan(juce::MathConstants<double>::pi * juce::jmin(static_cast<double>(frequencyValue), nyquistLimit) / sampleRate));
+    const float inverseG = 1.0f / g;
+    const float k = 1.0f / resonanceValue;
 
-        // Simple approximations for filter responses
-        double omega = 2.0 * M_PI * freqHz / currentSampleRate;
-        double cutoff = 2.0 * M_PI * frequency / currentSampleRate;
-        double q = resonance;
+    float *magnitudes = responseMagnitudes.data();
+    const float *prewarped = responsePrewarped.data();
 
-        switch (filterType)
+    for (int i = 0; i < responseSize; ++i)
+    {
+        const float x = prewarped[i] * inverseG;
+        const float real = 1.0f - x * x;
+        const float imaginary = k * x;
+        magnitudes[i] = 1.0f / std::sqrt(real * real + imaginary * imaginary);
+    }
+
+    // Numerator of each output; lowpass is 1
+    switch (typeValue)
+    {
+    case FilterType::BandPass:
+        for (int i = 0; i < responseSize; ++i)
+            magnitudes[i] *= k * prewarped[i] * inverseG;
+        break;
+
+    case FilterType::HighPass:
+        for (int i = 0; i < responseSize; ++i)
         {
-        case FilterType::LowPass:
-            // Simple lowpass filter response approximation
-            magnitude = 1.0 / sqrt(1.0 + pow((omega / cutoff), (2.0 * q)));
-            break;
-
-        case FilterType::HighPass:
-            // Simple highpass filter response approximation
-            magnitude = 1.0 / sqrt(1.0 + pow((cutoff / omega), (2.0 * q)));
-            break;
-
-        case FilterType::BandPass:
-            // Simple bandpass filter response approximation
-            {
-                double bw = 1.0 / q;
-                magnitude = 1.0 / (1.0 + pow((omega / cutoff - cutoff / omega) / bw, 2.0));
-            }
-            break;
-
-        default:
-            magnitude = 1.0;
-            break;
+            const float x = prewarped[i] * inverseG;
+            magnitudes[i] *= x * x;
         }
+        break;
 
-        magnitudes[i] = magnitude;
+    case FilterType::LowPass:
+    default:
+        break;
     }
-}
\ No newline at end of file
+
+    return responseMagnitudes;
+}
@@ -1,13 +1,8 @@
 #pragma once
 
 #include <JuceHeader.h>
-
-enum class FilterType
-{
-    LowPass,
-    BandPass,
-    HighPass
-};
+#include "BlockSmoother.h"
+#include "StateVariableFilter.h"
 
 class FilterProcessor
 {
@@ -31,24 +26,55 @@ public:
     juce::String getFilterTypeName() const;
     float getResonance() const;
 
-    // Get filter response for visual display
-    void getMagnitudeResponse(double *frequencies, double *magnitudes, int numPoints);
+    // Filter type identifiers in enum order, used for choice parameters and the UI
+    static juce::StringArray getFilterTypeNames();
+
+    // Number of log-spaced display points between 20 Hz and 20 kHz
+    static constexpr int responseSize = 100;
+
+    // Exact magnitude response for the given settings, evaluated from the filter's own
+    // transfer function. The editor passes the parameter values, so the display does not
+    // wait for the audio thread to pick an edit up. Cached, so it is only recomputed after
+    // a setting changes. Message thread only.
+    const std::array<float, responseSize> &getMagnitudeResponse(float frequency, FilterType type, float resonance);
 
 private:
-    // Parameters
-    float frequency;       // Filter cutoff frequency in Hz
-    FilterType filterType; // Type of filter
-    float resonance;       // Q factor / resonance
+    // Parameters (atomics so the UI can read them while the audio thread runs)
+    std::atomic<float> frequency;       // Filter cutoff frequency in Hz
+    std::atomic<FilterType> filterType; // Type of filter
+    std::atomic<float> resonance;       // Q factor / resonance
 
     // Internal state
-    double currentSampleRate;
+    std::atomic<double> currentSampleRate; // Also read by getMagnitudeResponse on the UI thread
     int bufferSize;
 
-    // Filters for each channel
-    std::vector<std::unique_ptr<juce::IIRFilter>> filters;
+    // Cutoff and resonance glide towards the snapshot; coefficients follow at control rate
+    BlockSmoother frequencySmoother;
+    BlockSmoother resonanceSmoother;
+
+    // Settings the current coefficients were built from
+    float appliedFrequency;
+    FilterType appliedFilterType;
+    float appliedResonance;
+
+    // Filters for each channel, sharing one set of coefficients
+    std::vector<StateVariableFilter> filters;
+    StateVariableFilter::Coefficients coefficients;
+
+    // Display response cache; prewarped frequency points depend only on the sample rate
+    std::array<float, responseSize> responsePrewarped{};
+    std::array<float, responseSize> responseMagnitudes{};
+    double responseSampleRate = 0.0;
+    float responseFrequency = -1.0f;
+    float responseResonance = -1.0f;
+    FilterType responseType = FilterType::LowPass;
+
+    // Rebuild filter coefficients for the given settings (audio thread or prepare only)
+    void updateFilters(float newFrequency, FilterType newType, float newResonance);
 
-    // Update filter coefficients based on current settings
-    void updateFilters();
+    // Runs every channel over a range, ramping coefficients when from and to differ
+    void processChannels(juce::AudioBuffer<float> &buffer, int startSample, int numSamples, FilterType type,
+                         const StateVariableFilter::Coefficients &from, const StateVariableFilter::Coefficients &to);
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(FilterProcessor)
 };
\ No newline at end of file
@@ -0,0 +1,111 @@
+#pragma once
+
+#include <JuceHeader.h>
+
+enum class FilterType
+{
+    LowPass,
+    BandPass,
+    HighPass
+};
+
+// Topology-preserving transform (zero-delay feedback) state-variable filter.
+//
+// One update produces lowpass, bandpass and highpass together, and the structure
+// stays stable under fast modulation and at high resonance right up to Nyquist,
+// which the direct-form biquad does not. Coefficients are three multipliers and a
+// damping term, so they can be interpolated linearly per sample while sweeping.
+class StateVariableFilter
+{
+public:
+    struct Coefficients
+    {
+        float k = 1.0f;  // Damping, 1 / Q
+        float a1 = 1.0f; // 1 / (1 + g (g + k))
+        float a2 = 0.0f; // g * a1
+        float a3 = 0.0f; // g * a2
+
+        static Coefficients make(double sampleRate, float cutoff, float resonance)
+        {
+            // Prewarped integrator gain; keep the cutoff just under Nyquist so tan stays finite
+            const double nyquistLimit = sampleRate * 0.49;
+            const double g = std::tan(juce::MathConstants<double>::pi * juce::jmin(static_cast<double>(cutoff), nyquistLimit) / sampleRate);
+            const double k = 1.0 / static_cast<double>(resonance);
+            const double a1 = 1.0 / (1.0 + g * (g + k));
+
+            Coefficients coefficients;
+            coefficients.k = static_cast<float>(k);
+            coefficients.a1 = static_cast<float>(a1);
+            coefficients.a2 = static_cast<float>(g * a1);
+            coefficients.a3 = static_cast<float>(g * g * a1);
+            return coefficients;
+        }
+    };
+
+    void reset()
+    {
+        ic1eq = 0.0f;
+        ic2eq = 0.0f;
+    }
+
+    // Filters a block in place with fixed coefficients
+    template <FilterType type>
+    void process(float *JUCE_RESTRICT data, int numSamples, const Coefficients &c)
+    {
+        float s1 = ic1eq, s2 = ic2eq;
+
+        for (int sample = 0; sample < numSamples; ++sample)
+            data[sample] = tick<type>(data[sample], c.k, c.a1, c.a2, c.a3, s1, s2);
+
+        ic1eq = s1;
+        ic2eq = s2;
+    }
+
+    // Filters a block in place while the coefficients move linearly from one set to the
+    // other, so a sweep costs a few extra adds per sample and no transcendental calls
+    template <FilterType type>
+    void processRamped(float *JUCE_RESTRICT data, int numSamples, const Coefficients &from, const Coefficients &to)
+    {
+        const float scale = 1.0f / static_cast<float>(numSamples);
+        const float kStep = (to.k - from.k) * scale;
+        const float a1Step = (to.a1 - from.a1) * scale;
+        const float a2Step = (to.a2 - from.a2) * scale;
+        const float a3Step = (to.a3 - from.a3) * scale;
+
+        float k = from.k, a1 = from.a1, a2 = from.a2, a3 = from.a3;
+        float s1 = ic1eq, s2 = ic2eq;
+
+        for (int sample = 0; sample < numSamples; ++sample)
+        {
+            k += kStep;
+            a1 += a1Step;
+            a2 += a2Step;
+            a3 += a3Step;
+            data[sample] = tick<type>(data[sample], k, a1, a2, a3, s1, s2);
+        }
+
+        ic1eq = s1;
+        ic2eq = s2;
+    }
+
+private:
+    template <FilterType type>
+    static float tick(float input, float k, float a1, float a2, float a3, float &s1, float &s2)
+    {
+        const float v3 = input - s2;
+        const float v1 = a1 * s1 + a2 * v3;
+        const float v2 = s2 + a2 * s1 + a3 * v3;
+        s1 = 2.0f * v1 - s1;
+        s2 = 2.0f * v2 - s2;
+
+        if constexpr (type == FilterType::LowPass)
+            return v2;
+        else if constexpr (type == FilterType::BandPass)
+            return k * v1; // Scaled for unity gain at the centre frequency
+        else
+            return input - k * v1 - v2;
+    }
+
+    float ic1eq = 0.0f;
+    float ic2eq = 0.0f;
+};
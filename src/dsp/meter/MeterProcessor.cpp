@@ -0,0 +1,162 @@
+#include "MeterProcessor.h"
+
+namespace
+{
+    // Integration time of the RMS reading
+    constexpr double rmsWindowSeconds = 0.3;
+
+    // Raises an atomic to value if it is higher. The reader may reset it concurrently,
+    // which the compare-exchange handles.
+    void storeMax(std::atomic<float> &target, float value)
+    {
+        float current = target.load(std::memory_order_relaxed);
+        while (value > current && !target.compare_exchange_weak(current, value, std::memory_order_relaxed))
+        {
+        }
+    }
+}
+
+MeterProcessor::MeterProcessor()
+    : maxBlockSamples(0),
+      currentSampleRate(44100.0)
+{
+    // 48-tap Kaiser-windowed sinc lowpass at the original Nyquist, as used for 4x true-peak
+    // interpolation. Each phase is normalised to unity gain at DC.
+    constexpr int numTaps = oversamplingFactor * tapsPerPhase;
+    std::array<double, numTaps> window;
+    juce::dsp::WindowingFunction<double>::fillWindowingTables(window.data(), numTaps,
+                                                              juce::dsp::WindowingFunction<double>::kaiser,
+                                                              false, 8.0);
+
+    const double centre = (numTaps - 1) * 0.5;
+
+    for (int phase = 0; phase < oversamplingFactor; ++phase)
+    {
+        std::array<double, tapsPerPhase> taps;
+        double sum = 0.0;
+
+        for (int k = 0; k < tapsPerPhase; ++k)
+        {
+            const int n = phase + k * oversamplingFactor;
+            const double x = (n - centre) / oversamplingFactor;
+            const double sinc = std::abs(x) < 1.0e-9 ? 1.0 : std::sin(juce::MathConstants<double>::pi * x) / (juce::MathConstants<double>::pi * x);
+            taps[static_cast<size_t>(k)] = sinc * window[static_cast<size_t>(n)];
+            sum += taps[static_cast<size_t>(k)];
+        }
+
+        // Tap k applies to the input k samples back, so reverse them to run oldest first
+        for (int k = 0; k < tapsPerPhase; ++k)
+            phaseCoefficients[static_cast<size_t>(phase)][static_cast<size_t>(tapsPerPhase - 1 - k)] =
+                static_cast<float>(taps[static_cast<size_t>(k)] / sum);
+    }
+
+    meanSquare.fill(0.0f);
+
+    for (int channel = 0; channel < maxChannels; ++channel)
+    {
+        peakHold[static_cast<size_t>(channel)] = 0.0f;
+        truePeakHold[static_cast<size_t>(channel)] = 0.0f;
+        rmsLevel[static_cast<size_t>(channel)] = 0.0f;
+    }
+}
+
+void MeterProcessor::prepare(double sampleRate, int maxBlockSize)
+{
+    currentSampleRate = sampleRate;
+    maxBlockSamples = juce::jmax(1, maxBlockSize);
+
+    for (auto &channelHistory : history)
+        channelHistory.assign(static_cast<size_t>(maxBlockSamples + tapsPerPhase - 1), 0.0f);
+
+    reset();
+}
+
+void MeterProcessor::reset()
+{
+    for (auto &channelHistory : history)
+        std::fill(channelHistory.begin(), channelHistory.end(), 0.0f);
+
+    meanSquare.fill(0.0f);
+
+    for (int channel = 0; channel < maxChannels; ++channel)
+    {
+        peakHold[static_cast<size_t>(channel)] = 0.0f;
+        truePeakHold[static_cast<size_t>(channel)] = 0.0f;
+        rmsLevel[static_cast<size_t>(channel)] = 0.0f;
+    }
+}
+
+void MeterProcessor::processBlock(const juce::AudioBuffer<float> &buffer)
+{
+    const int numChannels = juce::jmin(maxChannels, buffer.getNumChannels());
+    const int numSamples = buffer.getNumSamples();
+
+    if (maxBlockSamples == 0 || numSamples == 0)
+        return;
+
+    for (int channel = 0; channel < numChannels; ++channel)
+    {
+        const float *input = buffer.getReadPointer(channel);
+
+        // Hosts may exceed the prepared block size; meter in prepared-size pieces
+        for (int offset = 0; offset < numSamples; offset += maxBlockSamples)
+            processChannel(channel, input + offset, juce::jmin(maxBlockSamples, numSamples - offset));
+    }
+}
+
+void MeterProcessor::processChannel(int channel, const float *input, int numSamples)
+{
+    const auto index = static_cast<size_t>(channel);
+    float *window = history[index].data();
+    std::copy(input, input + numSamples, window + tapsPerPhase - 1);
+
+    float peak = 0.0f;
+    float truePeak = 0.0f;
+    float sumSquares = 0.0f;
+
+    // Sample peak, energy and the four interpolated points between this sample and the
+    // previous one, all from the same read of the history window
+    for (int sample = 0; sample < numSamples; ++sample)
+    {
+        const float x = input[sample];
+        peak = juce::jmax(peak, std::abs(x));
+        sumSquares += x * x;
+
+        const float *taps = window + sample;
+
+        for (const auto &coefficients : phaseCoefficients)
+        {
+            float interpolated = 0.0f;
+            for (int k = 0; k < tapsPerPhase; ++k)
+                interpolated += coefficients[static_cast<size_t>(k)] * taps[k];
+
+            truePeak = juce::jmax(truePeak, std::abs(interpolated));
+        }
+    }
+
+    // Keep the newest samples as the start of the next block's window
+    std::memmove(window, window + numSamples, sizeof(float) * static_cast<size_t>(tapsPerPhase - 1));
+
+    // Exponential integration of the block energy gives a window-independent RMS
+    const float blockMeanSquare = sumSquares / static_cast<float>(numSamples);
+    const float smoothing = 1.0f - static_cast<float>(std::exp(-numSamples / (rmsWindowSeconds * currentSampleRate)));
+    meanSquare[index] += (blockMeanSquare - meanSquare[index]) * smoothing;
+
+    storeMax(peakHold[index], peak);
+    storeMax(truePeakHold[index], juce::jmax(truePeak, peak));
+    rmsLevel[index].store(std::sqrt(meanSquare[index]), std::memory_order_relaxed);
+}
+
+MeterProcessor::Reading MeterProcessor::read(int channel)
+{
+    Reading reading;
+
+    if (!juce::isPositiveAndBelow(channel, maxChannels))
+        return reading;
+
+    const auto index = static_cast<size_t>(channel);
+    reading.peak = peakHold[index].exchange(0.0f, std::memory_order_relaxed);
+    reading.truePeak = truePeakHold[index].exchange(0.0f, std::memory_order_relaxed);
+    reading.rms = rmsLevel[index].load(std::memory_order_relaxed);
+    return reading;
+}
@@ -0,0 +1,61 @@
+#pragma once
+
+#include <JuceHeader.h>
+
+// Level meter for up to two channels.
+//
+// One pass over each channel measures the sample peak, the mean square and the
+// 4x-oversampled true peak (ITU-R BS.1770 style polyphase interpolation), so
+// inter-sample overs show up without a separate meter plugin. Results are
+// published through atomics: peaks are held until the UI reads them, so a
+// transient that falls between two UI frames is never lost. Ballistics are the
+// reader's job.
+class MeterProcessor
+{
+public:
+    static constexpr int maxChannels = 2;
+
+    struct Reading
+    {
+        float peak = 0.0f;     // Highest sample magnitude since the last read
+        float truePeak = 0.0f; // Highest interpolated magnitude since the last read
+        float rms = 0.0f;      // RMS over roughly the last 300 ms
+    };
+
+    MeterProcessor();
+    ~MeterProcessor() = default;
+
+    void prepare(double sampleRate, int maxBlockSize);
+    void reset();
+
+    // Audio thread only. Channels past maxChannels are ignored.
+    void processBlock(const juce::AudioBuffer<float> &buffer);
+
+    // Takes the current reading for a channel and clears its held peaks.
+    // Intended for a single reader on the message thread.
+    Reading read(int channel);
+
+private:
+    static constexpr int oversamplingFactor = 4;
+    static constexpr int tapsPerPhase = 12;
+
+    // Interpolation filter split into its four phases, with taps stored oldest first so
+    // each phase is a straight dot product over the history window
+    std::array<std::array<float, tapsPerPhase>, oversamplingFactor> phaseCoefficients;
+
+    // Per channel: the last tapsPerPhase - 1 samples of the previous block followed by
+    // room for one block, so the filter reads contiguous memory across block edges
+    std::array<std::vector<float>, maxChannels> history;
+    int maxBlockSamples;
+
+    double currentSampleRate;
+    std::array<float, maxChannels> meanSquare;
+
+    std::array<std::atomic<float>, maxChannels> peakHold;
+    std::array<std::atomic<float>, maxChannels> truePeakHold;
+    std::array<std::atomic<float>, maxChannels> rmsLevel;
+
+    void processChannel(int channel, const float *input, int numSamples);
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(MeterProcessor)
+};
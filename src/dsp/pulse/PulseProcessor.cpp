@@ -7,9 +7,24 @@ PulseProcessor::PulseProcessor()
       currentSampleRate(44100.0),
       bufferSize(0),
       phase(0.0),
-      phaseIncrement(0.0)
+      phaseIncrement(0.0),
+      beatsPerCycle(1.0),
+      depthTableCycleSeconds(0.0)
 {
-    updatePhaseIncrement();
+    // The amplitude starts silent at the top of each cycle and rises to full volume
+    // over the first quarter on a sine curve, then holds for the rest of the cycle
+    for (int i = 0; i <= tableSize; ++i)
+    {
+        const double phasePosition = static_cast<double>(i) / tableSize;
+        shapeTable[static_cast<size_t>(i)] =
+            phasePosition < 0.25 ? static_cast<float>(std::sin(phasePosition * 4.0 * juce::MathConstants<double>::halfPi))
+                                 : 1.0f;
+    }
+
+    for (int i = 0; i <= tableSize; ++i)
+        depthTable[static_cast<size_t>(i)] = 1.0f - shapeTable[static_cast<size_t>(i)];
+
+    updatePhaseIncrement(currentBpm.load(), currentRate.load());
 }
 
 void PulseProcessor::prepare(double sampleRate, int maxBlockSize)
@@ -20,114 +35,185 @@ void PulseProcessor::prepare(double sampleRate, int maxBlockSize)
     // Reset phase
     phase = 0.0;
 
-    // Configure the smoothed value to ramp over 10ms (good compromise between responsiveness and smoothness)
-    smoothedEnvelope.reset(sampleRate, 0.01);
-    smoothedEnvelope.setCurrentAndTargetValue(1.0f); // Start at full volume
+    gainCurve.assign(static_cast<size_t>(maxBlockSize), 0.0f);
+    depthTableCycleSeconds = 0.0;
+
+    mixSmoother.reset(sampleRate, 0.02);
+    mixSmoother.setCurrentAndTargetValue(mix.load());
 
     // Update phase increment for the new sample rate
-    updatePhaseIncrement();
+    updatePhaseIncrement(currentBpm.load(), currentRate.load());
 }
 
 void PulseProcessor::processBlock(juce::AudioBuffer<float> &buffer)
 {
-    // If mix is 0, no need to process
-    if (mix <= 0.001f)
-        return;
+    // Snapshot the parameters once so the whole block sees a consistent state
+    mixSmoother.setTargetValue(mix.load());
+    updatePhaseIncrement(currentBpm.load(), currentRate.load());
 
     const int numChannels = buffer.getNumChannels();
     const int numSamples = buffer.getNumSamples();
 
-    // Create a dry buffer for the mix calculation
-    juce::AudioBuffer<float> dryBuffer;
-    dryBuffer.makeCopyOf(buffer);
-
-    // Process each sample
-    for (int sample = 0; sample < numSamples; ++sample)
+    // If mix is (and stays) 0, no need to process; the free-running phase still
+    // advances so the pulse stays in time when it comes back
+    if ((!mixSmoother.isSmoothing() && mixSmoother.getTargetValue() <= 0.001f) || gainCurve.empty())
     {
-        // Calculate the target envelope value for this phase
-        float targetEnvelope = calculateEnvelope(phase);
+        mixSmoother.skip(numSamples);
+        phase = wrapPhase(phase + phaseIncrement * numSamples);
+        publishedPhase.store(static_cast<float>(phase));
+        return;
+    }
 
-        // Set the target for the smoothed value
-        smoothedEnvelope.setTargetValue(targetEnvelope);
+    if (phaseIncrement > 0.0)
+        updateDepthTable(1.0 / (phaseIncrement * currentSampleRate));
 
-        // Get the current smoothed value
-        float envelopeValue = smoothedEnvelope.getNextValue();
+    // Lock to the host grid: the phase at the start of the block comes straight from
+    // the song position, and a loop wrap inside the block gets its own resync point
+    int resyncSample = numSamples;
+    double resyncPhase = 0.0;
 
-        // Apply envelope to all channels
-        for (int channel = 0; channel < numChannels; ++channel)
+    if (transport.isPlaying && transport.hasPosition)
+    {
+        phase = wrapPhase(transport.ppqPosition / beatsPerCycle);
+
+        const double beatsPerSample = phaseIncrement * beatsPerCycle;
+        const double loopLength = transport.loopEndPpq - transport.loopStartPpq;
+
+        if (transport.isLooping && loopLength > 0.0 && beatsPerSample > 0.0 &&
+            transport.ppqPosition < transport.loopEndPpq)
         {
-            float *channelData = buffer.getWritePointer(channel);
-            const float *dryData = dryBuffer.getReadPointer(channel);
+            const int loopEndSample = static_cast<int>(std::ceil((transport.loopEndPpq - transport.ppqPosition) / beatsPerSample));
 
-            // Apply envelope with mix control
-            float wetSignal = dryData[sample] * envelopeValue;
-            channelData[sample] = (wetSignal * mix) + (dryData[sample] * (1.0f - mix));
+            if (loopEndSample < numSamples)
+            {
+                resyncSample = loopEndSample;
+                resyncPhase = wrapPhase(transport.loopStartPpq / beatsPerCycle);
+            }
         }
+    }
 
-        // Advance phase
-        phase += phaseIncrement;
-        if (phase >= 1.0)
-            phase -= 1.0;
+    // The whole effect is one gain curve, computed once and multiplied into every channel
+    const int capacity = static_cast<int>(gainCurve.size());
+
+    for (int offset = 0; offset < numSamples;)
+    {
+        // Chunks never straddle the loop resync point
+        const int limit = offset < resyncSample ? resyncSample : numSamples;
+        const int length = juce::jmin(capacity, limit - offset);
+
+        if (offset == resyncSample)
+            phase = resyncPhase;
+
+        const float mixStart = mixSmoother.getCurrentValue();
+        const float mixStep = (mixSmoother.skip(length) - mixStart) / static_cast<float>(length);
+        renderGainCurve(gainCurve.data(), length, mixStart, mixStep);
+
+        for (int channel = 0; channel < numChannels; ++channel)
+            juce::FloatVectorOperations::multiply(buffer.getWritePointer(channel, offset), gainCurve.data(), length);
+
+        offset += length;
     }
+
+    publishedPhase.store(static_cast<float>(phase));
+}
+
+double PulseProcessor::wrapPhase(double value)
+{
+    return value - std::floor(value);
 }
 
 void PulseProcessor::reset()
 {
     phase = 0.0;
-    smoothedEnvelope.reset(currentSampleRate, 0.01);
+    publishedPhase.store(0.0f);
 }
 
-float PulseProcessor::calculateEnvelope(double phasePosition) const
+void PulseProcessor::updateDepthTable(double cycleSeconds)
 {
-    // The amplitude will alternate between 0.0 (silence) and 1.0 (full volume)
-    // based on the phase position.
+    if (cycleSeconds == depthTableCycleSeconds)
+        return;
 
-    // We want a quarter note pulse, which means one up-down cycle per beat
-    // The pattern starts silent and then increases to full volume over an eighth note
+    depthTableCycleSeconds = cycleSeconds;
 
-    // Start with silent, then smoothly increase to full volume
-    if (phasePosition < 0.25)
+    // The jump from full volume back to silence at the cycle boundary would click,
+    // so the last 10ms of the cycle fade out along the mirrored attack curve
+    const double releaseFraction = juce::jlimit(1.0 / tableSize, 0.25, 0.01 / cycleSeconds);
+    const double releaseScale = 0.25 / releaseFraction;
+
+    for (int i = 0; i <= tableSize; ++i)
     {
-        // First quarter of the beat (eighth note) - ramp from silence to full volume
-        // Use a smooth sine curve for natural pumping effect
-        double normalizedPosition = phasePosition * 4.0; // Map 0.0-0.25 to 0.0-1.0
+        const double remaining = 1.0 - static_cast<double>(i) / tableSize;
+        float envelope = shapeTable[static_cast<size_t>(i)];
 
-        // Calculate curve using a sine function that starts at 0 and ends at 1
-        // sin function in range 0 to π/2 gives nice smooth curve from 0 to 1
-        double curveValue = std::sin(normalizedPosition * juce::MathConstants<double>::halfPi);
+        if (remaining < releaseFraction)
+            envelope *= shapeTable[static_cast<size_t>(juce::roundToInt(remaining * releaseScale * tableSize))];
 
-        // This gives us a smooth curve from 0 to 1
-        return static_cast<float>(curveValue);
+        // dry * (1 - mix) + dry * envelope * mix == dry * (1 - mix * (1 - envelope))
+        depthTable[static_cast<size_t>(i)] = 1.0f - envelope;
     }
-    else
+}
+
+void PulseProcessor::renderGainCurve(float *destination, int numSamples, float mixStart, float mixStep)
+{
+    const float startPhase = static_cast<float>(phase);
+    const float increment = static_cast<float>(phaseIncrement);
+    const float *table = depthTable.data();
+
+    for (int sample = 0; sample < numSamples; ++sample)
     {
-        // Rest of the beat - full volume
-        return 1.0f;
+        // Position within the cycle, wrapped without a branch
+        float position = startPhase + increment * static_cast<float>(sample);
+        position -= static_cast<float>(static_cast<int>(position));
+
+        const float tablePosition = position * static_cast<float>(tableSize);
+        const int index = juce::jmin(static_cast<int>(tablePosition), tableSize - 1);
+        const float fraction = tablePosition - static_cast<float>(index);
+
+        const float depth = table[index] + (table[index + 1] - table[index]) * fraction;
+        destination[sample] = 1.0f - (mixStart + mixStep * static_cast<float>(sample)) * depth;
     }
+
+    phase = wrapPhase(phase + phaseIncrement * numSamples);
 }
 
-void PulseProcessor::updatePhaseIncrement()
+void PulseProcessor::updatePhaseIncrement(double bpm, Rate rate)
 {
+    beatsPerCycle = getBeatsPerCycle(rate);
+
     // Convert BPM to phase increment per sample
-    double beatsPerSecond = currentBpm / 60.0;
+    phaseIncrement = (bpm / 60.0) / (beatsPerCycle * currentSampleRate);
+}
 
-    // Apply note value multiplier
-    double multiplier = 1.0;
-    switch (currentRate)
+double PulseProcessor::getBeatsPerCycle(Rate rate)
+{
+    switch (rate)
     {
     case Rate::Half:
-        multiplier = 0.5; // Half note: half the speed of quarter note
-        break;
-    case Rate::Quarter:
-        multiplier = 1.0; // Quarter note: standard beat
-        break;
+        return 2.0;
     case Rate::Eighth:
-        multiplier = 2.0; // Eighth note: twice the speed of quarter note
-        break;
+        return 0.5;
+    case Rate::Sixteenth:
+        return 0.25;
+    case Rate::HalfDotted:
+        return 3.0;
+    case Rate::QuarterDotted:
+        return 1.5;
+    case Rate::EighthDotted:
+        return 0.75;
+    case Rate::SixteenthDotted:
+        return 0.375;
+    case Rate::HalfTriplet:
+        return 4.0 / 3.0;
+    case Rate::QuarterTriplet:
+        return 2.0 / 3.0;
+    case Rate::EighthTriplet:
+        return 1.0 / 3.0;
+    case Rate::SixteenthTriplet:
+        return 1.0 / 6.0;
+    case Rate::Quarter:
+    default:
+        return 1.0;
     }
-
-    // Apply multiplier to beats per second
-    phaseIncrement = (beatsPerSecond * multiplier) / currentSampleRate;
 }
 
 void PulseProcessor::setMix(float newMix)
@@ -138,7 +224,11 @@ void PulseProcessor::setMix(float newMix)
 void PulseProcessor::setBpm(double newBpm)
 {
     currentBpm = juce::jlimit(20.0, 300.0, newBpm);
-    updatePhaseIncrement();
+}
+
+void PulseProcessor::setTransport(const PulseTransport &newTransport)
+{
+    transport = newTransport;
 }
 
 float PulseProcessor::getMix() const
@@ -151,40 +241,38 @@ double PulseProcessor::getBpm() const
     return currentBpm;
 }
 
+float PulseProcessor::getPhase() const
+{
+    return publishedPhase.load();
+}
+
 void PulseProcessor::setRate(Rate value)
 {
     currentRate = value;
-    updatePhaseIncrement();
 }
 
 void PulseProcessor::setRate(const juce::String &valueString)
 {
-    if (valueString == "1/2")
-        currentRate = Rate::Half;
-    else if (valueString == "1/8")
-        currentRate = Rate::Eighth;
-    else
-        currentRate = Rate::Quarter; // Default to quarter note (1/4)
-
-    updatePhaseIncrement();
+    // Default to quarter note (1/4) for unknown values
+    const int index = getRateNames().indexOf(valueString);
+    currentRate = index >= 0 ? static_cast<Rate>(index) : Rate::Quarter;
 }
 
 Rate PulseProcessor::getRate() const
 {
-    return currentRate;
+    return currentRate.load();
+}
+
+juce::StringArray PulseProcessor::getRateNames()
+{
+    return {"1/2", "1/4", "1/8", "1/16",
+            "1/2D", "1/4D", "1/8D", "1/16D",
+            "1/2T", "1/4T", "1/8T", "1/16T"};
 }
 
 juce::String PulseProcessor::getRateString() const
 {
-    switch (currentRate)
-    {
-    case Rate::Half:
-        return "1/2";
-    case Rate::Quarter:
-        return "1/4";
-    case Rate::Eighth:
-        return "1/8";
-    default:
-        return "1/4";
-    }
-}
\ No newline at end of file
+    const auto names = getRateNames();
+    const int index = static_cast<int>(currentRate.load());
+    return juce::isPositiveAndBelow(index, names.size()) ? names[index] : juce::String("1/4");
+}
@@ -1,12 +1,34 @@
 #pragma once
 
 #include <JuceHeader.h>
+#include "BlockSmoother.h"
 
+// New values are appended so saved parameter indices keep their meaning
 enum class Rate
 {
     Half,    // 1/2 note
     Quarter, // 1/4 note (default)
-    Eighth   // 1/8 note
+    Eighth,  // 1/8 note
+    Sixteenth,
+    HalfDotted,
+    QuarterDotted,
+    EighthDotted,
+    SixteenthDotted,
+    HalfTriplet,
+    QuarterTriplet,
+    EighthTriplet,
+    SixteenthTriplet
+};
+
+// Host transport state for one block, read from the AudioPlayHead
+struct PulseTransport
+{
+    bool isPlaying = false;
+    bool hasPosition = false;
+    double ppqPosition = 0.0;
+    bool isLooping = false;
+    double loopStartPpq = 0.0;
+    double loopEndPpq = 0.0;
 };
 
 class PulseProcessor
@@ -23,36 +45,70 @@ public:
     void setMix(float newMix);  // 0.0 - 1.0
     void setBpm(double newBpm); // In BPM
 
+    // Locks the pulse to the host grid for the next block (audio thread only).
+    // While the transport is stopped the pulse free-runs from where it was.
+    void setTransport(const PulseTransport &newTransport);
+
     // Parameter getters
     float getMix() const;
     double getBpm() const;
 
+    // Position in the pulse cycle (0 - 1) at the end of the last block, for the UI
+    float getPhase() const;
+
     // Note value parameter setters/getters
     void setRate(Rate value);
     void setRate(const juce::String &valueString);
     Rate getRate() const;
     juce::String getRateString() const;
 
+    // Rate identifiers in enum order, used for choice parameters and the UI
+    static juce::StringArray getRateNames();
+
+    // Length of one pulse cycle in quarter notes
+    static double getBeatsPerCycle(Rate rate);
+
 private:
-    // Parameters
-    float mix;         // Wet/dry mix
-    Rate currentRate;  // Note value for pulse rate
-    double currentBpm; // BPM for pulse timing
+    // Parameters (atomics so the UI can read them while the audio thread runs)
+    std::atomic<float> mix;         // Wet/dry mix
+    std::atomic<Rate> currentRate;  // Note value for pulse rate
+    std::atomic<double> currentBpm; // BPM for pulse timing
     double currentSampleRate;
     int bufferSize;
 
     // Internal phase for pulse generation
     double phase;
+    std::atomic<float> publishedPhase{0.0f}; // Copy of phase the UI can read
     double phaseIncrement;
+    double beatsPerCycle;
+
+    PulseTransport transport;
+
+    static double wrapPhase(double value);
+
+    // One cycle of the pulse shape, sampled once at construction (plus a guard point)
+    static constexpr int tableSize = 512;
+    std::array<float, tableSize + 1> shapeTable;
+
+    // How far below unity the shape dips (1 - envelope), with the anti-click release
+    // folded in. Independent of the mix, so it is rebuilt only when the cycle length changes.
+    std::array<float, tableSize + 1> depthTable;
+    double depthTableCycleSeconds;
+
+    // Wet/dry mix, ramped per block and applied to the looked-up depth
+    BlockSmoother mixSmoother;
+
+    // Per-block gain curve shared by all channels
+    std::vector<float> gainCurve;
 
-    // Smoothed envelope for anti-click transitions
-    juce::LinearSmoothedValue<float> smoothedEnvelope;
+    void updateDepthTable(double cycleSeconds);
 
-    // Calculate the pulse envelope value for a specific phase position
-    float calculateEnvelope(double phasePosition) const;
+    // Fills the gain curve from the table with the mix ramping from mixStart by mixStep
+    // per sample, and advances the phase
+    void renderGainCurve(float *destination, int numSamples, float mixStart, float mixStep);
 
-    // Update phase increment based on BPM
-    void updatePhaseIncrement();
+    // Update phase increment based on BPM and note value
+    void updatePhaseIncrement(double bpm, Rate rate);
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(PulseProcessor)
 };
\ No newline at end of file
@@ -0,0 +1,42 @@
+#pragma once
+
+#include <JuceHeader.h>
+
+// The interface the plugin editor drives, implemented by the web page (LayoutView) and
+// the natively drawn editor (NativeView). The editor owns one of them at a time and can
+// swap between them while open.
+class EditorView : public juce::Component
+{
+public:
+    ~EditorView() override = default;
+
+    // One frame of meter readings with ballistics applied. Bar and hold values are
+    // display heights (0 - 100) for input left/right then output left/right.
+    struct MeterLevels
+    {
+        static constexpr float silenceDb = -100.0f;
+
+        std::array<float, 4> bar{};
+        std::array<float, 4> hold{};
+        float outputTruePeakDb = silenceDb;
+    };
+
+    // Update levels for meters (shown with the next frame)
+    virtual void updateLevels(const MeterLevels &levels) = 0;
+
+    // Update the preset list in the dropdown
+    virtual void updatePresetList(const juce::StringArray &presets) = 0;
+
+    // Force a refresh of all UI parameters
+    virtual void refreshAllParameters() = 0;
+
+    // Shows whatever changed since the previous frame; driven by the editor's frame
+    // scheduler. parametersChanged reports a parameter edit since the last frame.
+    virtual void renderFrame(bool parametersChanged) = 0;
+
+    std::function<void(const juce::String &)> onPresetSelected;
+    std::function<void()> onSaveClicked;
+
+    // The user asked for the other kind of view
+    std::function<void()> onSwitchViewClicked;
+};
@@ -0,0 +1,94 @@
+#pragma once
+
+#include <JuceHeader.h>
+
+// Paces an editor's UI work off the display's vertical blank.
+//
+// onFrame runs at most frameRate times per second, and only while the component is
+// actually on screen; a minimised or hidden editor costs nothing. It receives the time
+// since the previous frame so anything animated can stay time-based. If frames start
+// taking a noticeable share of their interval, or vertical blanks arrive late because
+// the message thread is busy, the rate halves (down to a quarter) and recovers once
+// frames are cheap again.
+class FrameScheduler
+{
+public:
+    static constexpr double defaultFrameRate = 30.0;
+
+    explicit FrameScheduler(juce::Component &component, double frameRate = defaultFrameRate)
+        : owner(component),
+          baseInterval(1.0 / frameRate),
+          interval(baseInterval),
+          vblank(&component, [this](double timestampSeconds)
+                 { handleVBlank(timestampSeconds); })
+    {
+    }
+
+    // Called with the seconds since the previous frame (clamped after long gaps)
+    std::function<void(double elapsedSeconds)> onFrame;
+
+    // Current frame interval, after any throttling
+    double getFrameInterval() const { return interval; }
+
+private:
+    // Longest gap a frame reports, so a window that was hidden does not jump ahead
+    static constexpr double maxElapsedSeconds = 0.25;
+
+    // Frames are paced against the vertical blank, so allow one to land a little early
+    static constexpr double earlyTolerance = 0.9;
+
+    // Frames between throttling decisions, so the cost average settles first
+    static constexpr int framesPerRateCheck = 15;
+
+    void handleVBlank(double timestampSeconds)
+    {
+        if (onFrame == nullptr || !owner.isShowing())
+        {
+            // Start cleanly from the next visible vertical blank
+            lastFrameTime = -1.0;
+            return;
+        }
+
+        const double elapsed = lastFrameTime < 0.0 ? interval : timestampSeconds - lastFrameTime;
+        if (elapsed < interval * earlyTolerance)
+            return;
+
+        lastFrameTime = timestampSeconds;
+
+        const double startMs = juce::Time::getMillisecondCounterHiRes();
+        onFrame(juce::jmin(elapsed, maxElapsedSeconds));
+        const double cost = (juce::Time::getMillisecondCounterHiRes() - startMs) * 0.001;
+
+        averageCost += (cost - averageCost) * 0.1;
+        lateFrames += elapsed > interval * 3.0 ? 1 : 0;
+
+        if (++framesSinceRateCheck < framesPerRateCheck)
+            return;
+
+        const bool overloaded = averageCost > interval * 0.25 || lateFrames > framesPerRateCheck / 3;
+        const bool idle = averageCost < interval * 0.05 && lateFrames == 0;
+
+        if (overloaded && interval < baseInterval * 4.0)
+            interval *= 2.0;
+        else if (idle && interval > baseInterval)
+            interval = juce::jmax(baseInterval, interval * 0.5);
+
+        framesSinceRateCheck = 0;
+        lateFrames = 0;
+    }
+
+    juce::Component &owner;
+
+    const double baseInterval;
+    double interval;
+
+    double lastFrameTime = -1.0;
+    double averageCost = 0.0;
+    int framesSinceRateCheck = 0;
+    int lateFrames = 0;
+
+    // Declared last so it is attached only once everything above is initialised
+    juce::VBlankAttachment vblank;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(FrameScheduler)
+};
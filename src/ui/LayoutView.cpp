@@ -1,224 +1,110 @@
 #include "LayoutView.h"
 #include "BinaryData.h"
+#include "ParameterIDs.h"
 
-LayoutView::LayoutMessageHandler::LayoutMessageHandler(LayoutView &owner)
-    : ownerView(owner)
+namespace
 {
-}
-
-bool LayoutView::LayoutMessageHandler::pageAboutToLoad(const juce::String &url)
-{
-    // Handle oxide: protocol for control messages
-    if (url.startsWith("oxide:"))
+    // Writes one JSON object into a reused stream, a field at a time. Sections only
+    // open when their first changed field is written, so unchanged ones cost nothing.
+    class JsonObjectWriter
     {
-        juce::String params = url.fromFirstOccurrenceOf("oxide:", false, true);
+    public:
+        explicit JsonObjectWriter(juce::MemoryOutputStream &stream) : out(stream) {}
 
-        // Handle preset selection
-        if (params.startsWith("preset="))
-        {
-            juce::String presetName = params.fromFirstOccurrenceOf("preset=", false, true);
-            if (ownerView.onPresetSelected)
-                ownerView.onPresetSelected(presetName);
-            return false;
-        }
-        // Handle save action
-        else if (params.startsWith("action=save"))
-        {
-            if (ownerView.onSaveClicked)
-                ownerView.onSaveClicked();
-            return false;
-        }
-        // Handle input gain change
-        else if (params.startsWith("inputGain="))
-        {
-            float value = params.fromFirstOccurrenceOf("inputGain=", false, true).getFloatValue();
-            ownerView.setInputGain(value);
-            if (ownerView.onInputGainChanged)
-                ownerView.onInputGainChanged(value);
-            return false;
-        }
-        // Handle output gain change
-        else if (params.startsWith("outputGain="))
-        {
-            float value = params.fromFirstOccurrenceOf("outputGain=", false, true).getFloatValue();
-            ownerView.setOutputGain(value);
-            if (ownerView.onOutputGainChanged)
-                ownerView.onOutputGainChanged(value);
-            return false;
-        }
-        // Handle distortion parameters
-        else if (params.startsWith("drive="))
-        {
-            float value = params.fromFirstOccurrenceOf("drive=", false, true).getFloatValue();
-            ownerView.distortionProcessor.setDrive(value);
-            return false;
-        }
-        else if (params.startsWith("mix="))
-        {
-            float value = params.fromFirstOccurrenceOf("mix=", false, true).getFloatValue();
-            ownerView.distortionProcessor.setMix(value);
-            return false;
-        }
-        else if (params.startsWith("algorithm="))
+        juce::MemoryOutputStream &key(const char *name)
         {
-            juce::String value = params.fromFirstOccurrenceOf("algorithm=", false, true);
-            ownerView.distortionProcessor.setAlgorithm(value);
-            return false;
+            out << (empty ? "{\"" : ",\"") << name << "\":";
+            empty = false;
+            return out;
         }
-        // Handle delay parameters
-        else if (params.startsWith("delay:"))
-        {
-            params = params.fromFirstOccurrenceOf("delay:", false, true);
-
-            if (params.startsWith("time="))
-            {
-                float value = params.fromFirstOccurrenceOf("time=", false, true).getFloatValue();
-                ownerView.delayProcessor.setDelayTime(value);
-                return false;
-            }
-            else if (params.startsWith("feedback="))
-            {
-                float value = params.fromFirstOccurrenceOf("feedback=", false, true).getFloatValue();
-                ownerView.delayProcessor.setFeedback(value);
-                return false;
-            }
-            else if (params.startsWith("mix="))
-            {
-                float value = params.fromFirstOccurrenceOf("mix=", false, true).getFloatValue();
-                ownerView.delayProcessor.setMix(value);
-                return false;
-            }
-            else if (params.startsWith("pingpong="))
-            {
-                int value = params.fromFirstOccurrenceOf("pingpong=", false, true).getIntValue();
-                ownerView.delayProcessor.setPingPong(value > 0);
-                return false;
-            }
-        }
-        // Handle filter parameters
-        else if (params.startsWith("filter:"))
-        {
-            params = params.fromFirstOccurrenceOf("filter:", false, true);
-
-            if (params.startsWith("type="))
-            {
-                juce::String value = params.fromFirstOccurrenceOf("type=", false, true);
-                ownerView.filterProcessor.setFilterType(value);
-                return false;
-            }
-            else if (params.startsWith("frequency="))
-            {
-                float value = params.fromFirstOccurrenceOf("frequency=", false, true).getFloatValue();
-                ownerView.filterProcessor.setFrequency(value);
-                return false;
-            }
-            else if (params.startsWith("resonance="))
-            {
-                float value = params.fromFirstOccurrenceOf("resonance=", false, true).getFloatValue();
-                ownerView.filterProcessor.setResonance(value);
-                return false;
-            }
-        }
-        // Handle pulse parameters
-        else if (params.startsWith("pulse:"))
+
+        void number(const char *name, float value) { key(name) << juce::String(value); }
+        void text(const char *name, const juce::String &value) { key(name) << juce::JSON::toString(value); }
+        void flag(const char *name, bool value) { key(name) << (value ? "true" : "false"); }
+
+        bool isEmpty() const { return empty; }
+
+        // Closes the object if anything was written; returns whether it was
+        bool close()
         {
-            params = params.fromFirstOccurrenceOf("pulse:", false, true);
-
-            if (params.startsWith("mix="))
-            {
-                float value = params.fromFirstOccurrenceOf("mix=", false, true).getFloatValue();
-                ownerView.pulseProcessor.setMix(value);
-                return false;
-            }
-            else if (params.startsWith("rate="))
-            {
-                juce::String value = params.fromFirstOccurrenceOf("rate=", false, true);
-                ownerView.pulseProcessor.setRate(value);
-                return false;
-            }
+            if (!empty)
+                out << "}";
+            return !empty;
         }
 
-        return false; // We handled this URL
-    }
-    // Handle custom font loading
-    else if (url.startsWith("BinaryData::"))
-    {
-        // This is our own resource URL format
-        juce::String resourceName = url.substring(12);
-        int size = 0;
-        const char *data = nullptr;
+    private:
+        juce::MemoryOutputStream &out;
+        bool empty = true;
+    };
 
-        // Handle the font resource
-        if (resourceName == "old_english_hearts_ttf")
+    bool differs(float a, float b, float tolerance = 0.001f) { return std::abs(a - b) > tolerance; }
+
+    // Editor page from the build-time bundle, with the CSS and font already inlined.
+    // Decoded at most once per process and served from memory by the resource provider.
+    const std::vector<std::byte> &getPageBytes()
+    {
+        static const std::vector<std::byte> bytes = []
         {
-            data = BinaryData::old_english_hearts_ttf;
-            size = BinaryData::old_english_hearts_ttfSize;
-
-            if (data != nullptr && size > 0)
-            {
-                // Convert binary data to base64
-                juce::MemoryBlock mb(data, size);
-                juce::String base64 = mb.toBase64Encoding();
-
-                // Create a data URL for the font
-                juce::String dataUrl = "data:font/ttf;base64," + base64;
-
-                // Now navigate to this data URL
-                this->goToURL(dataUrl);
-                return false; // We've handled this URL
-            }
-        }
+#if OXIDE_UI_COMPRESSED
+            juce::MemoryInputStream compressed(BinaryData::layout_bundle_html, static_cast<size_t>(BinaryData::layout_bundle_htmlSize), false);
+            juce::GZIPDecompressorInputStream decompressor(&compressed, false, juce::GZIPDecompressorInputStream::gzipFormat);
+
+            juce::MemoryBlock page;
+            decompressor.readIntoMemoryBlock(page);
+            const auto *begin = static_cast<const std::byte *>(page.getData());
+            return std::vector<std::byte>(begin, begin + page.getSize());
+#else
+            const auto *begin = reinterpret_cast<const std::byte *>(BinaryData::layout_bundle_html);
+            return std::vector<std::byte>(begin, begin + BinaryData::layout_bundle_htmlSize);
+#endif
+        }();
+
+        return bytes;
     }
-
-    return true; // We didn't handle this URL
 }
 
 // Main LayoutView implementation
-LayoutView::LayoutView(DistortionProcessor &distProc, DelayProcessor &delayProc, FilterProcessor &filterProc, PulseProcessor &pulseProc)
-    : distortionProcessor(distProc),
-      delayProcessor(delayProc),
+LayoutView::LayoutView(juce::AudioProcessorValueTreeState &params, FilterProcessor &filterProc, PulseProcessor &pulseProc,
+                       ScopeFifo &fifo)
+    : parameters(params),
       filterProcessor(filterProc),
       pulseProcessor(pulseProc),
+      scopeFifo(fifo),
       pageLoaded(false),
-      inputGain(0.0f),
-      outputGain(0.0f),
-      lastLeftLevel(0.0f),
-      lastRightLevel(0.0f),
-      lastDrive(distProc.getDrive()),
-      lastMix(distProc.getMix()),
-      lastAlgorithm(distProc.getAlgorithmName()),
-      lastDelayTime(delayProc.getDelayTime()),
-      lastFeedback(delayProc.getFeedback()),
-      lastDelayMix(delayProc.getMix()),
-      lastPingPong(delayProc.getPingPong()),
-      lastFilterType(filterProc.getFilterTypeName()),
-      lastFilterFreq(filterProc.getFrequency()),
-      lastResonance(filterProc.getResonance()),
-      lastPulseMix(pulseProc.getMix()),
-      lastPulseRate(pulseProc.getRateString())
+      scopeHasNewData(false),
+      lastDrive(0.0f),
+      lastMix(0.0f),
+      lastAlgorithm(-1),
+      lastOversampling(-1),
+      lastDelayTime(0.0f),
+      lastFeedback(0.0f),
+      lastDelayMix(0.0f),
+      lastPingPong(false),
+      lastDelaySync(false),
+      lastDelayNote(-1),
+      lastFilterType(-1),
+      lastFilterFreq(0.0f),
+      lastResonance(0.0f),
+      lastPulseMix(0.0f),
+      lastPulseRate(-1),
+      lastPulseBpm(0.0f),
+      sentInputGain(0.0f),
+      sentOutputGain(0.0f),
+      presetListChanged(false),
+      forceFullState(true)
 {
-    auto browser = new LayoutMessageHandler(*this);
-    webView.reset(browser);
+    webView = std::make_unique<juce::WebBrowserComponent>(createWebViewOptions());
     webView->setFocusContainer(false);
     addAndMakeVisible(webView.get());
 
-    juce::String htmlContent = juce::String(BinaryData::layout_html, BinaryData::layout_htmlSize);
-    juce::String cssContent = juce::String(BinaryData::layout_css, BinaryData::layout_cssSize);
+    // The page is complete as bundled, so loading it is a straight copy out of BinaryData
+    webView->goToURL(juce::WebBrowserComponent::getResourceProviderRoot());
 
-    htmlContent = htmlContent.replace(
-        "<link rel=\"stylesheet\" href=\"./layout.css\" />",
-        "<style>\n" + cssContent + "\n    </style>");
-
-    // Load the combined HTML content
-    webView->goToURL("data:text/html;charset=utf-8," + htmlContent);
-
-    // Start timer for updates
-    startTimerHz(30);
+    // Nothing is sent until the page reports it is ready (see handlePageReady)
 }
 
 LayoutView::~LayoutView()
 {
-    stopTimer();
     webView = nullptr;
 }
 
@@ -233,399 +119,358 @@ void LayoutView::resized()
     webView->setBounds(getLocalBounds());
 }
 
-void LayoutView::timerCallback()
+void LayoutView::renderFrame(bool parametersChanged)
 {
-    // First few cycles, just wait for page to load
-    static int pageLoadCounter = 0;
     if (!pageLoaded)
-    {
-        pageLoadCounter++;
-        if (pageLoadCounter >= 10) // About 333ms with 30Hz timer
-        {
-            pageLoaded = true;
-
-            // Initialize with default values
-            juce::String script = "window.setAudioState(0, 0, 0, 0, " +
-                                  juce::String(inputGain) + ", " +
-                                  juce::String(outputGain) + ")";
-            webView->evaluateJavascript(script);
-        }
         return;
-    }
 
-    // Check for parameter changes in distortion processor
-    float drive = distortionProcessor.getDrive();
-    float mix = distortionProcessor.getMix();
-    juce::String algorithm = distortionProcessor.getAlgorithmName();
+    scopeHasNewData = scopeTrace.drain(scopeFifo) || scopeHasNewData;
+    sendStateUpdate(parametersChanged);
+}
+
+void LayoutView::handlePageReady()
+{
+    // Also sent again if the page reloads, which starts it from its defaults
+    pageLoaded = true;
+    forceFullState = true;
+    presetListChanged = true;
+
+    // The whole initial state goes out in one message; the editor's frames send diffs
+    scopeHasNewData = scopeTrace.drain(scopeFifo) || scopeHasNewData;
+    sendStateUpdate(true);
+}
 
-    bool distortionChanged = std::abs(drive - lastDrive) > 0.001f ||
-                             std::abs(mix - lastMix) > 0.001f ||
-                             algorithm != lastAlgorithm;
+float LayoutView::getParameterValue(const char *parameterId) const
+{
+    return parameters.getRawParameterValue(parameterId)->load();
+}
 
-    if (distortionChanged)
+void LayoutView::sendStateUpdate(bool parametersChanged)
+{
+    const bool force = forceFullState;
+    forceFullState = false;
+
+    // Values come straight from the parameter store, which is current as soon as an edit,
+    // automation or state recall lands, whether or not the audio thread has run since
+    const bool checkParameters = force || parametersChanged;
+    const auto choiceIndex = [this](const char *parameterId) { return juce::roundToInt(getParameterValue(parameterId)); };
+    const auto choiceName = [](const juce::StringArray &names, int index) { return names[juce::jlimit(0, names.size() - 1, index)]; };
+
+    // The whole frame goes out as one message holding only what changed since the last one
+    frameScript.reset();
+    frameScript << "window.applyState(";
+    JsonObjectWriter root(frameScript);
+
+    // Distortion
+    if (checkParameters)
     {
-        // Update distortion UI with current values
-        juce::String script = "window.setDistortionValues(" +
-                              juce::String(drive) + ", " +
-                              juce::String(mix) + ", '" +
-                              algorithm + "')";
-        webView->evaluateJavascript(script);
-
-        lastDrive = drive;
-        lastMix = mix;
-        lastAlgorithm = algorithm;
+        const float drive = getParameterValue(ParameterIDs::drive);
+        const float mix = getParameterValue(ParameterIDs::mix);
+        const int algorithm = choiceIndex(ParameterIDs::algorithm);
+        const int oversampling = choiceIndex(ParameterIDs::oversampling);
+
+        JsonObjectWriter section(frameScript);
+        const auto open = [&]() -> JsonObjectWriter & { if (section.isEmpty()) root.key("distortion"); return section; };
+
+        if (force || differs(drive, lastDrive))
+            open().number("drive", lastDrive = drive);
+        if (force || differs(mix, lastMix))
+            open().number("mix", lastMix = mix);
+        if (force || algorithm != lastAlgorithm)
+            open().text("algorithm", choiceName(DistortionProcessor::getAlgorithmNames(), lastAlgorithm = algorithm));
+        if (force || oversampling != lastOversampling)
+            open().text("oversampling", choiceName(DistortionProcessor::getOversamplingNames(), lastOversampling = oversampling));
+
+        section.close();
     }
 
-    // Check for parameter changes in delay processor
-    float delayTime = delayProcessor.getDelayTime();
-    float feedback = delayProcessor.getFeedback();
-    float delayMix = delayProcessor.getMix();
-    bool pingPong = delayProcessor.getPingPong();
-
-    bool delayChanged = std::abs(delayTime - lastDelayTime) > 0.001f ||
-                        std::abs(feedback - lastFeedback) > 0.001f ||
-                        std::abs(delayMix - lastDelayMix) > 0.001f ||
-                        pingPong != lastPingPong;
+    // Delay
+    if (checkParameters)
+    {
+        const float delayTime = getParameterValue(ParameterIDs::delayTime);
+        const float feedback = getParameterValue(ParameterIDs::delayFeedback);
+        const float delayMix = getParameterValue(ParameterIDs::delayMix);
+        const bool pingPong = getParameterValue(ParameterIDs::pingPong) >= 0.5f;
+        const bool delaySync = getParameterValue(ParameterIDs::delaySync) >= 0.5f;
+        const int delayNote = choiceIndex(ParameterIDs::delayNote);
+
+        JsonObjectWriter section(frameScript);
+        const auto open = [&]() -> JsonObjectWriter & { if (section.isEmpty()) root.key("delay"); return section; };
+
+        if (force || differs(delayTime, lastDelayTime))
+            open().number("time", lastDelayTime = delayTime);
+        if (force || differs(feedback, lastFeedback))
+            open().number("feedback", lastFeedback = feedback);
+        if (force || differs(delayMix, lastDelayMix))
+            open().number("mix", lastDelayMix = delayMix);
+        if (force || pingPong != lastPingPong)
+            open().flag("pingPong", lastPingPong = pingPong);
+        if (force || delaySync != lastDelaySync)
+            open().flag("sync", lastDelaySync = delaySync);
+        if (force || delayNote != lastDelayNote)
+            open().text("note", choiceName(DelayProcessor::getNoteValueNames(), lastDelayNote = delayNote));
+
+        section.close();
+    }
 
-    if (delayChanged)
+    // Filter; the response curve follows any change to the settings it depends on
+    if (checkParameters)
     {
-        // Update delay UI with current values
-        juce::String script = "window.setDelayValues(" +
-                              juce::String(delayTime) + ", " +
-                              juce::String(feedback) + ", " +
-                              juce::String(delayMix) + ", " +
-                              juce::String(pingPong ? "1" : "0") + ")";
-        webView->evaluateJavascript(script);
-
-        lastDelayTime = delayTime;
-        lastFeedback = feedback;
-        lastDelayMix = delayMix;
-        lastPingPong = pingPong;
+        const int filterType = choiceIndex(ParameterIDs::filterType);
+        const float filterFreq = getParameterValue(ParameterIDs::filterFrequency);
+        const float resonance = getParameterValue(ParameterIDs::filterResonance);
+
+        JsonObjectWriter section(frameScript);
+        const auto open = [&]() -> JsonObjectWriter & { if (section.isEmpty()) root.key("filter"); return section; };
+
+        if (force || filterType != lastFilterType)
+            open().text("type", choiceName(FilterProcessor::getFilterTypeNames(), lastFilterType = filterType));
+        if (force || differs(filterFreq, lastFilterFreq))
+            open().number("frequency", lastFilterFreq = filterFreq);
+        if (force || differs(resonance, lastResonance))
+            open().number("resonance", lastResonance = resonance);
+        if (!section.isEmpty())
+            section.key("response") << prepareFilterResponseData();
+
+        section.close();
     }
 
-    // Check for parameter changes in filter processor
-    juce::String filterType = filterProcessor.getFilterTypeName();
-    float filterFreq = filterProcessor.getFrequency();
-    float resonance = filterProcessor.getResonance();
+    // Pulse; the tempo comes from the host, so it is checked every frame
+    {
+        const float pulseBpm = static_cast<float>(pulseProcessor.getBpm());
 
-    bool filterChanged = filterType != lastFilterType ||
-                         std::abs(filterFreq - lastFilterFreq) > 0.001f ||
-                         std::abs(resonance - lastResonance) > 0.001f;
+        JsonObjectWriter section(frameScript);
+        const auto open = [&]() -> JsonObjectWriter & { if (section.isEmpty()) root.key("pulse"); return section; };
 
-    if (filterChanged)
-    {
-        // Update filter UI with current values
-        juce::String script = "window.setFilterValues('" +
-                              filterType + "', " +
-                              juce::String(filterFreq) + ", " +
-                              juce::String(resonance) + ")";
-        webView->evaluateJavascript(script);
-
-        lastFilterType = filterType;
-        lastFilterFreq = filterFreq;
-        lastResonance = resonance;
-    }
+        if (checkParameters)
+        {
+            const float pulseMix = getParameterValue(ParameterIDs::pulseMix);
+            const int pulseRate = choiceIndex(ParameterIDs::pulseRate);
 
-    // Check for parameter changes in pulse processor
-    float pulseMix = pulseProcessor.getMix();
-    juce::String pulseRate = pulseProcessor.getRateString();
-    bool pulseChanged = std::abs(pulseMix - lastPulseMix) > 0.001f || pulseRate != lastPulseRate;
+            if (force || differs(pulseMix, lastPulseMix))
+                open().number("mix", lastPulseMix = pulseMix);
+            if (force || pulseRate != lastPulseRate)
+                open().text("rate", choiceName(PulseProcessor::getRateNames(), lastPulseRate = pulseRate));
+        }
 
-    if (pulseChanged)
-    {
-        // Update pulse UI with current values
-        juce::String script = "window.setPulseValues(" +
-                              juce::String(pulseMix) + ", '" +
-                              pulseRate + "', " +
-                              juce::String(pulseProcessor.getBpm()) + ")";
-        webView->evaluateJavascript(script);
-
-        lastPulseMix = pulseMix;
-        lastPulseRate = pulseRate;
+        if (force || differs(pulseBpm, lastPulseBpm, 0.01f))
+            open().number("bpm", lastPulseBpm = pulseBpm);
+
+        section.close();
     }
 
-    // Update oscilloscope if there's new audio data
+    // Meters; values are shown to one decimal, so smaller moves are not worth sending
     {
-        juce::ScopedLock lock(bufferLock);
-        if (latestBuffer.getNumChannels() > 0 && latestBuffer.getNumSamples() > 0)
+        JsonObjectWriter section(frameScript);
+        const auto open = [&]() -> JsonObjectWriter & { if (section.isEmpty()) root.key("meters"); return section; };
+
+        auto writeLevels = [&](const char *name, const std::array<float, 4> &values, std::array<float, 4> &sent)
         {
-            juce::String dataJson = prepareWaveformData();
-            juce::String script = "window.updateOscilloscopeData(" + dataJson + ")";
-            webView->evaluateJavascript(script);
-        }
-    }
-}
+            bool changed = force;
+            for (size_t i = 0; i < values.size(); ++i)
+                changed = changed || differs(values[i], sent[i], 0.05f);
 
-void LayoutView::updateBuffer(const juce::AudioBuffer<float> &buffer)
-{
-    juce::ScopedLock lock(bufferLock);
+            if (!changed)
+                return;
 
-    // Update our buffer copy with the latest audio data
-    if (buffer.getNumChannels() == 0 || buffer.getNumSamples() == 0)
-        return;
+            auto &out = open().key(name);
+            for (size_t i = 0; i < values.size(); ++i)
+                out << (i == 0 ? "[" : ",") << juce::String(values[i], 1);
+            out << "]";
+            sent = values;
+        };
 
-    latestBuffer.makeCopyOf(buffer);
-}
+        writeLevels("bars", lastLevels.bar, sentLevels.bar);
+        writeLevels("holds", lastLevels.hold, sentLevels.hold);
 
-void LayoutView::updateLevels(float leftLevel, float rightLevel, float outLeftLevel, float outRightLevel)
-{
-    if (!pageLoaded)
-        return;
+        if (force || differs(lastLevels.outputTruePeakDb, sentLevels.outputTruePeakDb, 0.05f))
+            open().key("truePeak") << juce::String(sentLevels.outputTruePeakDb = lastLevels.outputTruePeakDb, 1);
 
-    // Store the last known levels
-    lastLeftLevel = leftLevel;
-    lastRightLevel = rightLevel;
-
-    // If signal is very close to zero, explicitly set it to zero
-    if (leftLevel < 0.01f)
-        leftLevel = 0.0f;
-    if (rightLevel < 0.01f)
-        rightLevel = 0.0f;
-    if (outLeftLevel < 0.01f)
-        outLeftLevel = 0.0f;
-    if (outRightLevel < 0.01f)
-        outRightLevel = 0.0f;
-
-    try
+        if (checkParameters)
+        {
+            const float inputGain = getParameterValue(ParameterIDs::inputGain);
+            const float outputGain = getParameterValue(ParameterIDs::outputGain);
+
+            if (force || differs(inputGain, sentInputGain, 0.05f))
+                open().key("inputGain") << juce::String(sentInputGain = inputGain, 1);
+            if (force || differs(outputGain, sentOutputGain, 0.05f))
+                open().key("outputGain") << juce::String(sentOutputGain = outputGain, 1);
+        }
+
+        section.close();
+    }
+
+    // Preset names; the page derives each option's value from its name
+    if (force || presetListChanged)
     {
-        // Ensure values are valid by using String conversion with proper formatting
-        juce::String script = "window.setAudioState(" +
-                              juce::String(leftLevel, 1) + ", " +
-                              juce::String(rightLevel, 1) + ", " +
-                              juce::String(outLeftLevel, 1) + ", " +
-                              juce::String(outRightLevel, 1) + ", " +
-                              juce::String(inputGain, 1) + ", " +
-                              juce::String(outputGain, 1) + ")";
-
-        webView->evaluateJavascript(script);
+        auto &out = root.key("presets");
+        out << "[";
+        for (int i = 0; i < presetList.size(); ++i)
+            out << (i == 0 ? "" : ",") << juce::JSON::toString(presetList[i]);
+        out << "]";
+        presetListChanged = false;
     }
-    catch (const std::exception &e)
+
+    // Oscilloscope, only when audio has arrived and changes the trace (a stopped or
+    // silent signal sends nothing)
+    if (scopeHasNewData)
     {
-        // Log any errors for debugging
-        juce::Logger::writeToLog("JavaScript error in meters: " + juce::String(e.what()));
+        if (scopeTrace.update() || force)
+            appendWaveformData(root.key("scope"));
+
+        scopeHasNewData = false;
     }
-}
 
-void LayoutView::setInputGain(float newGain)
-{
-    inputGain = newGain;
-    // Force an update of the UI with current levels but new gain settings
-    updateLevels(lastLeftLevel, lastRightLevel, 0.0f, 0.0f);
+    // Nothing changed, so there is nothing to send
+    if (!root.close())
+        return;
+
+    frameScript << ")";
+    webView->evaluateJavascript(frameScript.toString());
 }
 
-void LayoutView::setOutputGain(float newGain)
+juce::WebBrowserComponent::Options LayoutView::createWebViewOptions()
 {
-    outputGain = newGain;
-    // Force an update of the UI with current levels but new gain settings
-    updateLevels(lastLeftLevel, lastRightLevel, 0.0f, 0.0f);
+    // The page looks parameters up by index into this list and converts choice names
+    // to indices itself, so every message from it is already a plain number
+    juce::Array<juce::var> parameterIds;
+    for (const auto *parameterId : ParameterIDs::bridgeOrder)
+        parameterIds.add(juce::String(parameterId));
+
+    auto *choices = new juce::DynamicObject();
+    choices->setProperty(ParameterIDs::algorithm, DistortionProcessor::getAlgorithmNames());
+    choices->setProperty(ParameterIDs::oversampling, DistortionProcessor::getOversamplingNames());
+    choices->setProperty(ParameterIDs::delayNote, DelayProcessor::getNoteValueNames());
+    choices->setProperty(ParameterIDs::filterType, FilterProcessor::getFilterTypeNames());
+    choices->setProperty(ParameterIDs::pulseRate, PulseProcessor::getRateNames());
+
+    return juce::WebBrowserComponent::Options{}
+        .withBackend(juce::WebBrowserComponent::Options::Backend::webview2)
+        .withWinWebView2Options(juce::WebBrowserComponent::Options::WinWebView2{}
+                                    .withUserDataFolder(juce::File::getSpecialLocation(juce::File::tempDirectory)))
+        .withNativeIntegrationEnabled()
+        .withResourceProvider([](const juce::String &url) -> std::optional<juce::WebBrowserComponent::Resource>
+                              {
+                                  if (url != "/" && url != "/index.html")
+                                      return std::nullopt;
+
+                                  return juce::WebBrowserComponent::Resource{getPageBytes(), "text/html"};
+                              })
+        .withInitialisationData("parameterIds", parameterIds)
+        .withInitialisationData("choices", juce::var(choices))
+        .withEventListener("pageReady", [this](const juce::var &)
+                           { handlePageReady(); })
+        .withEventListener("parameters", [this](const juce::var &payload)
+                           { handleParameterMessage(payload); })
+        .withEventListener("preset", [this](const juce::var &payload)
+                           {
+                               if (onPresetSelected)
+                                   onPresetSelected(payload.toString());
+                           })
+        .withEventListener("save", [this](const juce::var &)
+                           {
+                               if (onSaveClicked)
+                                   onSaveClicked();
+                           })
+        .withEventListener("switchView", [this](const juce::var &)
+                           {
+                               if (onSwitchViewClicked)
+                                   onSwitchViewClicked();
+                           });
 }
 
-juce::String LayoutView::prepareWaveformData()
+void LayoutView::handleParameterMessage(const juce::var &payload)
 {
-    juce::ScopedLock lock(bufferLock);
-
-    // Number of data points to display
-    const int numPoints = 128;
-
-    if (latestBuffer.getNumChannels() == 0 || latestBuffer.getNumSamples() == 0)
-        return "[]";
-
-    // Create a JSON array of waveform data points
-    juce::String jsonArray = "[";
+    // Flat [index, value, index, value, ...] list; the page has already coalesced a
+    // drag down to the latest value per parameter
+    const auto *values = payload.getArray();
+    if (values == nullptr)
+        return;
 
-    // Combine channels if stereo
-    if (latestBuffer.getNumChannels() > 1)
+    for (int i = 0; i + 1 < values->size(); i += 2)
     {
-        const float *leftChannel = latestBuffer.getReadPointer(0);
-        const float *rightChannel = latestBuffer.getReadPointer(1);
+        const int index = static_cast<int>((*values)[i]);
+        const float value = static_cast<float>(static_cast<double>((*values)[i + 1]));
 
-        // Sample the buffer at regular intervals
-        const int samplesPerPoint = juce::jmax(1, latestBuffer.getNumSamples() / numPoints);
+        if (!juce::isPositiveAndBelow(index, static_cast<int>(ParameterIDs::bridgeOrder.size())))
+            continue;
 
-        for (int i = 0; i < numPoints && i * samplesPerPoint < latestBuffer.getNumSamples(); ++i)
+        const juce::String parameterId = ParameterIDs::bridgeOrder[static_cast<size_t>(index)];
+
+        // Gains are in dB, so a negative value is valid for them
+        if (parameterId == ParameterIDs::inputGain || parameterId == ParameterIDs::outputGain)
+        {
+            if (onParameterChanged)
+                onParameterChanged(parameterId, value);
+        }
+        else
         {
-            // Average the samples in this segment
-            float sum = 0.0f;
-            int count = 0;
-
-            for (int j = 0; j < samplesPerPoint && i * samplesPerPoint + j < latestBuffer.getNumSamples(); ++j)
-            {
-                int sampleIndex = i * samplesPerPoint + j;
-                // Average of left and right channels
-                sum += (leftChannel[sampleIndex] + rightChannel[sampleIndex]) * 0.5f;
-                count++;
-            }
-
-            // Calculate average value for this point
-            float value = count > 0 ? sum / count : 0.0f;
-
-            // Add to JSON array
-            jsonArray += juce::String(value);
-
-            // Add comma if not the last item
-            if (i < numPoints - 1 && (i + 1) * samplesPerPoint < latestBuffer.getNumSamples())
-                jsonArray += ",";
+            notifyParameterChanged(parameterId, value);
         }
     }
-    else // Mono
-    {
-        const float *channel = latestBuffer.getReadPointer(0);
+}
 
-        // Sample the buffer at regular intervals
-        const int samplesPerPoint = juce::jmax(1, latestBuffer.getNumSamples() / numPoints);
+void LayoutView::notifyParameterChanged(const juce::String &parameterId, float value)
+{
+    // Unknown choice names map to -1; ignore them rather than sending garbage to the host
+    if (value < 0.0f)
+        return;
 
-        for (int i = 0; i < numPoints && i * samplesPerPoint < latestBuffer.getNumSamples(); ++i)
-        {
-            // Average the samples in this segment
-            float sum = 0.0f;
-            int count = 0;
+    if (onParameterChanged)
+        onParameterChanged(parameterId, value);
+}
 
-            for (int j = 0; j < samplesPerPoint && i * samplesPerPoint + j < latestBuffer.getNumSamples(); ++j)
-            {
-                sum += channel[i * samplesPerPoint + j];
-                count++;
-            }
+void LayoutView::updateLevels(const MeterLevels &levels)
+{
+    // Picked up by the next frame
+    lastLevels = levels;
+}
 
-            // Calculate average value for this point
-            float value = count > 0 ? sum / count : 0.0f;
+juce::String LayoutView::prepareFilterResponseData()
+{
+    // Drawn from the settings the page was just sent; the processor caches the response,
+    // so an unchanged curve only costs the formatting
+    const auto type = static_cast<FilterType>(juce::jlimit(0, FilterProcessor::getFilterTypeNames().size() - 1, lastFilterType));
+    const auto &magnitudes = filterProcessor.getMagnitudeResponse(lastFilterFreq, type, lastResonance);
 
-            // Add to JSON array
-            jsonArray += juce::String(value);
+    juce::String jsonArray;
+    jsonArray.preallocateBytes(static_cast<size_t>(magnitudes.size()) * 7 + 2);
+    jsonArray += "[";
 
-            // Add comma if not the last item
-            if (i < numPoints - 1 && (i + 1) * samplesPerPoint < latestBuffer.getNumSamples())
-                jsonArray += ",";
-        }
+    for (size_t i = 0; i < magnitudes.size(); ++i)
+    {
+        if (i > 0)
+            jsonArray += ",";
+
+        jsonArray += juce::String(magnitudes[i], 4);
     }
 
     jsonArray += "]";
     return jsonArray;
 }
 
+void LayoutView::appendWaveformData(juce::MemoryOutputStream &out)
+{
+    // The page decodes the bytes straight into a Float32Array, which is little-endian
+    // on every platform the plugin ships for
+    out << "\"";
+    const auto &minMax = scopeTrace.getMinMax();
+    juce::Base64::convertToBase64(out, minMax.data(), sizeof(minMax));
+    out << "\"";
+}
+
 void LayoutView::updatePresetList(const juce::StringArray &presets)
 {
-    // Store the preset list
+    // Goes out with the next frame, or with the initial state if the page is not ready yet
     presetList = presets;
-
-    // Only update if page is loaded
-    if (!pageLoaded)
-        return;
-
-    try
-    {
-        // Create a JavaScript array string for the presets
-        juce::String jsArrayString = "[";
-
-        for (int i = 0; i < presets.size(); ++i)
-        {
-            juce::String displayName = presets[i];
-            juce::String valueName = displayName.replaceCharacters(" ", "_").toLowerCase();
-
-            jsArrayString += "{\"value\":\"" + valueName + "\", \"text\":\"" + displayName + "\"}";
-            if (i < presets.size() - 1)
-                jsArrayString += ", ";
-        }
-
-        jsArrayString += "]";
-
-        // Create JavaScript to update the dropdown
-        juce::String script =
-            "const presetDropdown = document.getElementById('presetDropdown');\n"
-            "// Clear existing options\n"
-            "presetDropdown.innerHTML = '';\n"
-            "\n"
-            "// Add new preset options\n"
-            "const presets = " +
-            jsArrayString + ";\n"
-                            "presets.forEach(preset => {\n"
-                            "    const option = document.createElement('option');\n"
-                            "    option.value = preset.value;\n" // Use underscore value
-                            "    option.text = preset.text;\n"   // Use display text with spaces
-                            "    presetDropdown.appendChild(option);\n"
-                            "});\n";
-
-        // Evaluate the JavaScript to update the dropdown
-        webView->evaluateJavascript(script, nullptr);
-    }
-    catch (const std::exception &)
-    {
-        // Silently handle any JavaScript errors
-    }
+    presetListChanged = true;
 }
 
 void LayoutView::refreshAllParameters()
 {
     // Force an immediate refresh of all parameters
+    forceFullState = true;
 
-    // Distortion parameters
-    {
-        float drive = distortionProcessor.getDrive();
-        float mix = distortionProcessor.getMix();
-        juce::String algorithm = distortionProcessor.getAlgorithmName();
-
-        juce::String script = "window.setDistortionValues(" +
-                              juce::String(drive) + ", " +
-                              juce::String(mix) + ", '" +
-                              algorithm + "')";
-        webView->evaluateJavascript(script);
-
-        lastDrive = drive;
-        lastMix = mix;
-        lastAlgorithm = algorithm;
-    }
-
-    // Delay parameters
-    {
-        float delayTime = delayProcessor.getDelayTime();
-        float feedback = delayProcessor.getFeedback();
-        float delayMix = delayProcessor.getMix();
-        bool pingPong = delayProcessor.getPingPong();
-
-        juce::String script = "window.setDelayValues(" +
-                              juce::String(delayTime) + ", " +
-                              juce::String(feedback) + ", " +
-                              juce::String(delayMix) + ", " +
-                              juce::String(pingPong ? "1" : "0") + ")";
-        webView->evaluateJavascript(script);
-
-        lastDelayTime = delayTime;
-        lastFeedback = feedback;
-        lastDelayMix = delayMix;
-        lastPingPong = pingPong;
-    }
-
-    // Filter parameters
-    {
-        juce::String filterType = filterProcessor.getFilterTypeName();
-        float filterFreq = filterProcessor.getFrequency();
-        float resonance = filterProcessor.getResonance();
-
-        juce::String script = "window.setFilterValues('" +
-                              filterType + "', " +
-                              juce::String(filterFreq) + ", " +
-                              juce::String(resonance) + ")";
-        webView->evaluateJavascript(script);
-
-        lastFilterType = filterType;
-        lastFilterFreq = filterFreq;
-        lastResonance = resonance;
-    }
-
-    // Pulse parameters
-    {
-        float pulseMix = pulseProcessor.getMix();
-        juce::String pulseRate = pulseProcessor.getRateString();
-
-        juce::String script = "window.setPulseValues(" +
-                              juce::String(pulseMix) + ", '" +
-                              pulseRate + "', " +
-                              juce::String(pulseProcessor.getBpm()) + ")";
-        webView->evaluateJavascript(script);
-
-        lastPulseMix = pulseMix;
-        lastPulseRate = pulseRate;
-    }
-
-    // Update levels
-    updateLevels(lastLeftLevel, lastRightLevel, 0.0f, 0.0f);
-}
\ No newline at end of file
+    if (pageLoaded)
+        sendStateUpdate(true);
+}
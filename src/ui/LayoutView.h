@@ -5,98 +5,114 @@
 #include "DelayProcessor.h"
 #include "FilterProcessor.h"
 #include "PulseProcessor.h"
+#include "ScopeFifo.h"
+#include "ScopeTrace.h"
+#include "EditorView.h"
 
-class LayoutView : public juce::Component,
-                   private juce::Timer
+// Editor view rendered by the system web engine from the bundled page
+class LayoutView : public EditorView
 {
 public:
-    LayoutView(DistortionProcessor &distortionProcessor,
-               DelayProcessor &delayProcessor,
+    LayoutView(juce::AudioProcessorValueTreeState &parameters,
                FilterProcessor &filterProcessor,
-               PulseProcessor &pulseProcessor);
+               PulseProcessor &pulseProcessor,
+               ScopeFifo &scopeFifo);
     ~LayoutView() override;
 
     void paint(juce::Graphics &g) override;
     void resized() override;
 
-    // Update audio buffer for oscilloscope
-    void updateBuffer(const juce::AudioBuffer<float> &buffer);
+    // EditorView
+    void updateLevels(const MeterLevels &levels) override;
+    void updatePresetList(const juce::StringArray &presets) override;
+    void refreshAllParameters() override;
+    void renderFrame(bool parametersChanged) override;
 
-    // Update levels for meters
-    void updateLevels(float leftLevel, float rightLevel, float outLeftLevel, float outRightLevel);
-
-    // Set input/output gain values
-    void setInputGain(float newGain);
-    void setOutputGain(float newGain);
-
-    // Update the preset list in the dropdown
-    void updatePresetList(const juce::StringArray &presets);
-
-    // Force a refresh of all UI parameters
-    void refreshAllParameters();
-
-    // Callback functions for parameter changes
-    std::function<void(float)> onInputGainChanged;
-    std::function<void(float)> onOutputGainChanged;
-    std::function<void(const juce::String &)> onPresetSelected;
-    std::function<void()> onSaveClicked;
-
-    // URL handler for callbacks from JS
-    class LayoutMessageHandler : public juce::WebBrowserComponent
-    {
-    public:
-        LayoutMessageHandler(LayoutView &owner);
-        bool pageAboutToLoad(const juce::String &url) override;
-
-    private:
-        LayoutView &ownerView;
-    };
+    // Called for every control the page edits (choice parameters as an index)
+    std::function<void(const juce::String &parameterId, float plainValue)> onParameterChanged;
 
 private:
-    DistortionProcessor &distortionProcessor;
-    DelayProcessor &delayProcessor;
+    juce::AudioProcessorValueTreeState &parameters;
     FilterProcessor &filterProcessor;
     PulseProcessor &pulseProcessor;
+    ScopeFifo &scopeFifo;
 
     std::unique_ptr<juce::WebBrowserComponent> webView;
 
-    // State tracking variables
+    // Set once the page has signalled it is ready
     bool pageLoaded;
-    juce::CriticalSection bufferLock;
-    juce::AudioBuffer<float> latestBuffer;
+
+    // The scope is sent as its min/max pairs of Float32 in base64
+    ScopeTrace scopeTrace;
+    bool scopeHasNewData;
     juce::StringArray presetList;
 
-    // Input/Output
-    float inputGain;
-    float outputGain;
-    float lastLeftLevel;
-    float lastRightLevel;
+    MeterLevels lastLevels;
 
-    // Distortion
+    // Parameter values the page last received, read from the parameter store (choice
+    // parameters as indices)
     float lastDrive;
     float lastMix;
-    juce::String lastAlgorithm;
+    int lastAlgorithm;
+    int lastOversampling;
 
-    // Delay
     float lastDelayTime;
     float lastFeedback;
     float lastDelayMix;
     bool lastPingPong;
+    bool lastDelaySync;
+    int lastDelayNote;
 
-    // Filter
-    juce::String lastFilterType;
+    int lastFilterType;
     float lastFilterFreq;
     float lastResonance;
 
-    // Pulse
     float lastPulseMix;
-    juce::String lastPulseRate;
+    int lastPulseRate;
+
+    // Host tempo the page last received
+    float lastPulseBpm;
+
+    // Meter values the page last received; the gains are parameters, read from the store
+    MeterLevels sentLevels;
+    float sentInputGain;
+    float sentOutputGain;
+
+    // The preset list has changed since the page last received it
+    bool presetListChanged;
+
+    // Next frame sends every field, e.g. after page load or a preset change
+    bool forceFullState;
+
+    // Reused for every frame's state message
+    juce::MemoryOutputStream frameScript;
+
+    // Native bridge (the page emits "pageReady", "parameters", "preset", "save" and
+    // "switchView" events) and the resource provider serving the bundled page
+    juce::WebBrowserComponent::Options createWebViewOptions();
+
+    // Applies a batch of [parameter index, plain value] pairs sent by the page
+    void handleParameterMessage(const juce::var &payload);
+
+    // Forwards a UI edit to the parameter store (choice parameters are passed as an index)
+    void notifyParameterChanged(const juce::String &parameterId, float value);
+
+    // Called when the page has loaded and can take state: sends the full state at once
+    void handlePageReady();
+
+    // Filter magnitude response for the last sent settings, as a JSON array matching the
+    // page's frequency grid
+    juce::String prepareFilterResponseData();
+
+    // Current plain value of a parameter in the store
+    float getParameterValue(const char *parameterId) const;
 
-    // Timer callback for UI updates
-    void timerCallback() override;
+    // Sends one message with every field that changed since the previous frame. Parameter
+    // sections are only compared when the store reports an edit (or the whole state is due).
+    void sendStateUpdate(bool parametersChanged);
 
-    // Prepare waveform data for oscilloscope
-    juce::String prepareWaveformData();
+    // Writes the scope trace's min/max pairs as a quoted base64 string
+    void appendWaveformData(juce::MemoryOutputStream &out);
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(LayoutView)
 };
\ No newline at end of file
@@ -0,0 +1,654 @@
+#include "NativeView.h"
+#include "BinaryData.h"
+#include "ParameterIDs.h"
+#include "DistortionProcessor.h"
+#include "DelayProcessor.h"
+
+namespace
+{
+    // Theme colours, as in theme.scss
+    const juce::Colour primaryColour{0xffe73c0c};
+    const juce::Colour primaryHover{0xffff4d23};
+    const juce::Colour backgroundDarker{0xff121212};
+    const juce::Colour surfaceColour{0xff333333};
+    const juce::Colour surfaceHighlight{0xff444444};
+    const juce::Colour textPrimary{0xffffffff};
+    const juce::Colour textSecondary{0xffdddddd};
+    const juce::Colour textMuted{0xff999999};
+    const juce::Colour successColour{0xff20c020};
+    const juce::Colour warningColour{0xffffb400};
+    const juce::Colour dangerColour{0xffff2200};
+
+    // Knobs sweep 270 degrees from lower left to lower right, as on the page
+    constexpr float rotaryStart = juce::MathConstants<float>::pi * 1.25f;
+    constexpr float rotaryEnd = juce::MathConstants<float>::pi * 2.75f;
+
+    // Pixels of vertical drag for a knob's full range, as on the page
+    constexpr int knobDragPixels = 100;
+
+    class NativeLookAndFeel : public juce::LookAndFeel_V4
+    {
+    public:
+        NativeLookAndFeel()
+        {
+            setColour(juce::Label::textColourId, textSecondary);
+            setColour(juce::ComboBox::backgroundColourId, backgroundDarker);
+            setColour(juce::ComboBox::outlineColourId, textPrimary);
+            setColour(juce::ComboBox::textColourId, textPrimary);
+            setColour(juce::ComboBox::arrowColourId, textPrimary);
+            setColour(juce::PopupMenu::backgroundColourId, backgroundDarker);
+            setColour(juce::PopupMenu::textColourId, textPrimary);
+            setColour(juce::PopupMenu::highlightedBackgroundColourId, primaryColour);
+            setColour(juce::PopupMenu::highlightedTextColourId, textPrimary);
+            setColour(juce::TextButton::buttonColourId, primaryColour);
+            setColour(juce::TextButton::buttonOnColourId, primaryHover);
+            setColour(juce::TextButton::textColourOffId, textPrimary);
+            setColour(juce::TextButton::textColourOnId, textPrimary);
+            setColour(juce::ToggleButton::textColourId, textSecondary);
+            setColour(juce::ToggleButton::tickColourId, primaryColour);
+            setColour(juce::ToggleButton::tickDisabledColourId, textMuted);
+            setColour(juce::BubbleComponent::backgroundColourId, backgroundDarker);
+            setColour(juce::BubbleComponent::outlineColourId, surfaceHighlight);
+        }
+
+        void drawRotarySlider(juce::Graphics &g, int x, int y, int width, int height, float sliderPos,
+                              float startAngle, float endAngle, juce::Slider &) override
+        {
+            const auto bounds = juce::Rectangle<int>(x, y, width, height).toFloat().reduced(1.0f);
+            const float diameter = juce::jmin(bounds.getWidth(), bounds.getHeight());
+            const auto knob = bounds.withSizeKeepingCentre(diameter, diameter);
+
+            g.setGradientFill(juce::ColourGradient(juce::Colour(0xff333333), knob.getTopLeft(),
+                                                   juce::Colour(0xff222222), knob.getBottomRight(), false));
+            g.fillEllipse(knob);
+
+            const float border = diameter > 16.0f ? 2.0f : 1.0f;
+            g.setColour(surfaceHighlight);
+            g.drawEllipse(knob.reduced(border * 0.5f), border);
+
+            // Indicator from the centre, in the page's proportions (12 px on a 32 px knob)
+            const float angle = startAngle + sliderPos * (endAngle - startAngle);
+            const float length = diameter * 0.375f;
+
+            juce::Path indicator;
+            indicator.addRectangle(-border * 0.5f, -length, border, length);
+
+            g.setColour(primaryColour);
+            g.fillPath(indicator, juce::AffineTransform::rotation(angle).translated(knob.getCentre()));
+        }
+
+        juce::Font getComboBoxFont(juce::ComboBox &) override { return juce::Font(juce::FontOptions(11.0f)); }
+
+        juce::Font getTextButtonFont(juce::TextButton &, int) override { return juce::Font(juce::FontOptions(14.0f)); }
+    };
+
+    // "soft_clip" -> "Soft Clip"
+    juce::String toDisplayName(const juce::String &identifier)
+    {
+        auto words = juce::StringArray::fromTokens(identifier, "_", "");
+        for (auto &word : words)
+            word = word.substring(0, 1).toUpperCase() + word.substring(1);
+
+        return words.joinIntoString(" ");
+    }
+
+    // Choice attachments select by item index, so items follow the parameter's order
+    void addChoices(juce::ComboBox &box, const juce::StringArray &names)
+    {
+        for (int i = 0; i < names.size(); ++i)
+            box.addItem(toDisplayName(names[i]), i + 1);
+    }
+
+    bool differs(float a, float b, float tolerance = 0.05f) { return std::abs(a - b) > tolerance; }
+}
+
+// Knob
+NativeView::Knob::Knob(const juce::String &name, bool isSmall)
+    : small(isSmall)
+{
+    slider.setSliderStyle(juce::Slider::RotaryVerticalDrag);
+    slider.setRotaryParameters(rotaryStart, rotaryEnd, true);
+    slider.setTextBoxStyle(juce::Slider::NoTextBox, false, 0, 0);
+    slider.setMouseDragSensitivity(knobDragPixels);
+    slider.addListener(this);
+    addAndMakeVisible(slider);
+
+    // Small knobs have no room for labels; their value shows while dragging
+    if (small)
+    {
+        slider.setPopupDisplayEnabled(true, false, nullptr);
+        return;
+    }
+
+    nameLabel.setText(name, juce::dontSendNotification);
+    nameLabel.setJustificationType(juce::Justification::centred);
+    nameLabel.setFont(juce::Font(juce::FontOptions(10.0f)));
+    addAndMakeVisible(nameLabel);
+
+    valueLabel.setJustificationType(juce::Justification::centred);
+    valueLabel.setFont(juce::Font(juce::FontOptions(10.0f)));
+    valueLabel.setColour(juce::Label::textColourId, textPrimary);
+    addAndMakeVisible(valueLabel);
+}
+
+NativeView::Knob::~Knob()
+{
+    slider.removeListener(this);
+}
+
+void NativeView::Knob::resized()
+{
+    auto area = getLocalBounds();
+
+    if (small)
+    {
+        slider.setBounds(area);
+        return;
+    }
+
+    slider.setBounds(area.removeFromTop(36).withSizeKeepingCentre(36, 36));
+    nameLabel.setBounds(area.removeFromTop(12));
+    valueLabel.setBounds(area.removeFromTop(12));
+}
+
+void NativeView::Knob::updateValueText()
+{
+    if (!small)
+        valueLabel.setText(slider.getTextFromValue(slider.getValue()), juce::dontSendNotification);
+}
+
+void NativeView::Knob::sliderValueChanged(juce::Slider *)
+{
+    updateValueText();
+}
+
+// Main NativeView implementation
+NativeView::NativeView(juce::AudioProcessorValueTreeState &params, FilterProcessor &filterProc, PulseProcessor &pulseProc,
+                       ScopeFifo &fifo)
+    : parameters(params),
+      filterProcessor(filterProc),
+      pulseProcessor(pulseProc),
+      scopeFifo(fifo),
+      lookAndFeel(std::make_unique<NativeLookAndFeel>()),
+      titleTypeface(juce::Typeface::createSystemTypefaceFor(BinaryData::old_english_hearts_ttf,
+                                                            BinaryData::old_english_hearts_ttfSize)),
+      saveButton("Save"),
+      viewButton("Web"),
+      delayTimeKnob("Time", false),
+      delayFeedbackKnob("Feedback", false),
+      delayMixKnob("Mix", false),
+      driveKnob("Drive", false),
+      mixKnob("Mix", false),
+      filterFrequencyKnob("Frequency", false),
+      filterResonanceKnob("Resonance", false),
+      pulseMixKnob("Amount", false),
+      pulseRateKnob("Rate", false),
+      inputGainKnob("Input", true),
+      outputGainKnob("Output", true)
+{
+    setLookAndFeel(lookAndFeel.get());
+
+    // Header
+    presetBox.onChange = [this]()
+    {
+        if (onPresetSelected && presetBox.getSelectedId() > 0)
+            onPresetSelected(presetBox.getText());
+    };
+    saveButton.onClick = [this]()
+    {
+        if (onSaveClicked)
+            onSaveClicked();
+    };
+    viewButton.setColour(juce::TextButton::buttonColourId, surfaceColour);
+    viewButton.onClick = [this]()
+    {
+        if (onSwitchViewClicked)
+            onSwitchViewClicked();
+    };
+
+    pingPongButton.setButtonText("Ping Pong");
+
+    for (auto *component : std::initializer_list<juce::Component *>{
+             &presetBox, &saveButton, &viewButton,
+             &delayTimeKnob, &delayFeedbackKnob, &delayMixKnob, &delayNoteBox, &pingPongButton,
+             &driveKnob, &mixKnob, &algorithmBox, &oversamplingBox,
+             &filterFrequencyKnob, &filterResonanceKnob, &filterTypeBox,
+             &pulseMixKnob, &pulseRateKnob,
+             &inputGainKnob, &outputGainKnob})
+        addAndMakeVisible(component);
+
+    attachControls();
+}
+
+NativeView::~NativeView()
+{
+    setLookAndFeel(nullptr);
+}
+
+void NativeView::attachControls()
+{
+    auto attachKnob = [this](Knob &knob, const char *parameterId, std::function<juce::String(double)> format)
+    {
+        sliderAttachments.push_back(std::make_unique<SliderAttachment>(parameters, parameterId, knob.slider));
+
+        // The attachment installs the parameter's own text; replace it with the page's format
+        knob.slider.textFromValueFunction = std::move(format);
+        knob.updateValueText();
+    };
+
+    auto percent = [](double value)
+    { return juce::String(juce::roundToInt(value * 100.0)) + "%"; };
+    auto decibels = [](double value)
+    { return juce::String(value, 1) + " dB"; };
+
+    attachKnob(driveKnob, ParameterIDs::drive, percent);
+    attachKnob(mixKnob, ParameterIDs::mix, percent);
+    attachKnob(inputGainKnob, ParameterIDs::inputGain, decibels);
+    attachKnob(outputGainKnob, ParameterIDs::outputGain, decibels);
+    attachKnob(delayTimeKnob, ParameterIDs::delayTime, [](double seconds)
+               { return juce::String(juce::roundToInt(seconds * 1000.0)) + "ms"; });
+    attachKnob(delayFeedbackKnob, ParameterIDs::delayFeedback, percent);
+    attachKnob(delayMixKnob, ParameterIDs::delayMix, percent);
+    attachKnob(filterFrequencyKnob, ParameterIDs::filterFrequency, [](double hz)
+               { return hz < 1000.0 ? juce::String(juce::roundToInt(hz)) + " Hz" : juce::String(hz / 1000.0, 1) + " kHz"; });
+    attachKnob(filterResonanceKnob, ParameterIDs::filterResonance, [](double q)
+               { return juce::String(q, 1); });
+    attachKnob(pulseMixKnob, ParameterIDs::pulseMix, percent);
+
+    addChoices(algorithmBox, DistortionProcessor::getAlgorithmNames());
+    addChoices(oversamplingBox, DistortionProcessor::getOversamplingNames());
+    addChoices(filterTypeBox, FilterProcessor::getFilterTypeNames());
+    comboBoxAttachments.push_back(std::make_unique<ComboBoxAttachment>(parameters, ParameterIDs::algorithm, algorithmBox));
+    comboBoxAttachments.push_back(std::make_unique<ComboBoxAttachment>(parameters, ParameterIDs::oversampling, oversamplingBox));
+    comboBoxAttachments.push_back(std::make_unique<ComboBoxAttachment>(parameters, ParameterIDs::filterType, filterTypeBox));
+
+    pingPongAttachment = std::make_unique<ButtonAttachment>(parameters, ParameterIDs::pingPong, pingPongButton);
+
+    // One selector drives both delay sync parameters, as on the page
+    const auto noteNames = DelayProcessor::getNoteValueNames();
+    delayNoteBox.addItem("Free", 1);
+    for (int i = 0; i < noteNames.size(); ++i)
+        delayNoteBox.addItem(noteNames[i], i + 2);
+
+    delaySyncAttachment = std::make_unique<juce::ParameterAttachment>(
+        *parameters.getParameter(ParameterIDs::delaySync), [this](float value)
+        {
+            delaySyncOn = value >= 0.5f;
+            updateDelayNoteBox();
+        });
+    delayNoteAttachment = std::make_unique<juce::ParameterAttachment>(
+        *parameters.getParameter(ParameterIDs::delayNote), [this](float value)
+        {
+            delayNoteIndex = juce::roundToInt(value);
+            updateDelayNoteBox();
+        });
+
+    delayNoteBox.onChange = [this]()
+    {
+        const int itemId = delayNoteBox.getSelectedId();
+        if (itemId <= 0)
+            return;
+
+        if (itemId > 1)
+            delayNoteAttachment->setValueAsCompleteGesture(static_cast<float>(itemId - 2));
+
+        delaySyncAttachment->setValueAsCompleteGesture(itemId > 1 ? 1.0f : 0.0f);
+    };
+
+    delaySyncAttachment->sendInitialUpdate();
+    delayNoteAttachment->sendInitialUpdate();
+
+    // Pulse rate knob positions run from the longest cycle to the shortest
+    const auto rateNames = PulseProcessor::getRateNames();
+    for (int i = 0; i < rateNames.size(); ++i)
+        pulseRateByPosition.push_back(i);
+
+    std::stable_sort(pulseRateByPosition.begin(), pulseRateByPosition.end(), [](int a, int b)
+                     { return PulseProcessor::getBeatsPerCycle(static_cast<Rate>(a)) >
+                              PulseProcessor::getBeatsPerCycle(static_cast<Rate>(b)); });
+
+    auto &rateSlider = pulseRateKnob.slider;
+    rateSlider.setRange(0.0, static_cast<double>(rateNames.size() - 1), 1.0);
+    rateSlider.textFromValueFunction = [this, rateNames](double position)
+    {
+        const int index = juce::jlimit(0, static_cast<int>(pulseRateByPosition.size()) - 1, juce::roundToInt(position));
+        return rateNames[pulseRateByPosition[static_cast<size_t>(index)]];
+    };
+
+    pulseRateAttachment = std::make_unique<juce::ParameterAttachment>(
+        *parameters.getParameter(ParameterIDs::pulseRate), [this](float value)
+        {
+            const auto position = std::find(pulseRateByPosition.begin(), pulseRateByPosition.end(), juce::roundToInt(value));
+            pulseRateKnob.slider.setValue(static_cast<double>(position - pulseRateByPosition.begin()), juce::dontSendNotification);
+            pulseRateKnob.updateValueText();
+        });
+
+    rateSlider.onDragStart = [this]()
+    { pulseRateAttachment->beginGesture(); };
+    rateSlider.onDragEnd = [this]()
+    { pulseRateAttachment->endGesture(); };
+    rateSlider.onValueChange = [this]()
+    {
+        const auto position = static_cast<size_t>(juce::roundToInt(pulseRateKnob.slider.getValue()));
+        const auto index = static_cast<float>(pulseRateByPosition[position]);
+
+        if (pulseRateKnob.slider.isMouseButtonDown())
+            pulseRateAttachment->setValueAsPartOfGesture(index);
+        else
+            pulseRateAttachment->setValueAsCompleteGesture(index);
+    };
+
+    pulseRateAttachment->sendInitialUpdate();
+}
+
+void NativeView::updateDelayNoteBox()
+{
+    delayNoteBox.setSelectedId(delaySyncOn ? delayNoteIndex + 2 : 1, juce::dontSendNotification);
+}
+
+void NativeView::updateLevels(const MeterLevels &levels)
+{
+    // Repaint only the meters whose readings moved visibly
+    for (size_t i = 0; i < meterBounds.size(); ++i)
+    {
+        if (differs(levels.bar[i], shownLevels.bar[i]) || differs(levels.hold[i], shownLevels.hold[i]))
+            repaint(meterBounds[i]);
+    }
+
+    if (differs(levels.outputTruePeakDb, shownLevels.outputTruePeakDb))
+        repaint(truePeakBounds);
+
+    shownLevels = levels;
+}
+
+void NativeView::updatePresetList(const juce::StringArray &presets)
+{
+    const juce::String selected = presetBox.getText();
+
+    presetBox.clear(juce::dontSendNotification);
+    presetBox.addItemList(presets, 1);
+
+    const int index = presets.indexOf(selected);
+    presetBox.setSelectedItemIndex(juce::jmax(0, index), juce::dontSendNotification);
+}
+
+void NativeView::refreshAllParameters()
+{
+    // Controls follow their attachments; only the filter display needs recomputing
+    updateFilterResponse();
+    repaint();
+}
+
+void NativeView::renderFrame(bool parametersChanged)
+{
+    if (parametersChanged)
+        updateFilterResponse();
+
+    if (scopeTrace.drain(scopeFifo) && scopeTrace.update())
+        repaint(scopeBounds);
+
+    const float pulseLight = getPulseLight();
+    if (differs(pulseLight, shownPulseLight, 0.01f))
+    {
+        shownPulseLight = pulseLight;
+        repaint(pulseLightBounds);
+    }
+}
+
+void NativeView::updateFilterResponse()
+{
+    // Drawn from the parameter store, which already holds an edit the filter stage may
+    // not have picked up yet
+    const auto value = [this](const char *parameterId) { return parameters.getRawParameterValue(parameterId)->load(); };
+    const int typeIndex = juce::jlimit(0, FilterProcessor::getFilterTypeNames().size() - 1,
+                                       juce::roundToInt(value(ParameterIDs::filterType)));
+
+    const auto &response = filterProcessor.getMagnitudeResponse(value(ParameterIDs::filterFrequency), static_cast<FilterType>(typeIndex),
+                                                                value(ParameterIDs::filterResonance));
+    if (response != shownResponse)
+    {
+        shownResponse = response;
+        repaint(filterDisplayBounds);
+    }
+}
+
+float NativeView::getPulseLight() const
+{
+    // The light stays off, and costs nothing, while the pulse is not in use
+    if (parameters.getRawParameterValue(ParameterIDs::pulseMix)->load() < 0.01f)
+        return 0.0f;
+
+    // Follows the phase the audio thread is actually playing (locked to the host grid
+    // while the transport runs): flashes at the start of each cycle and fades over it
+    return 1.0f - pulseProcessor.getPhase();
+}
+
+void NativeView::resized()
+{
+    // Fixed layout matching the page at the editor's canvas size
+    titleBounds = {16, 0, 220, 60};
+    viewButton.setBounds(644, 14, 60, 32);
+    saveButton.setBounds(572, 14, 64, 32);
+    presetBox.setBounds(397, 12, 160, 36);
+
+    // Meters
+    meterBounds[0] = {20, 80, 8, 170};
+    meterBounds[1] = {34, 80, 8, 170};
+    meterBounds[2] = {678, 80, 8, 170};
+    meterBounds[3] = {692, 80, 8, 170};
+    truePeakBounds = {668, 252, 40, 14};
+    inputGainKnob.setBounds(22, 272, 18, 18);
+    outputGainKnob.setBounds(680, 272, 18, 18);
+
+    // Delay
+    delayTimeKnob.setBounds(60, 66, 60, 60);
+    delayFeedbackKnob.setBounds(124, 66, 60, 60);
+    delayMixKnob.setBounds(188, 66, 60, 60);
+    delayNoteBox.setBounds(62, 134, 64, 20);
+    pingPongButton.setBounds(132, 134, 100, 20);
+    delayTitleBounds = {60, 160, 186, 16};
+
+    leftSeparatorBounds = {64, 186, 180, 1};
+
+    // Distortion
+    algorithmBox.setBounds(62, 194, 78, 20);
+    oversamplingBox.setBounds(144, 194, 40, 20);
+    distortionTitleBounds = {186, 194, 60, 20};
+    driveKnob.setBounds(92, 224, 60, 60);
+    mixKnob.setBounds(156, 224, 60, 60);
+
+    // Oscilloscope
+    scopeBounds = {250, 80, 220, 220};
+
+    // Filter
+    filterFrequencyKnob.setBounds(474, 66, 60, 60);
+    filterResonanceKnob.setBounds(536, 66, 60, 60);
+    filterDisplayBounds = {600, 72, 60, 40};
+    filterTitleBounds = {474, 134, 186, 20};
+    filterTypeBox.setBounds(560, 134, 96, 20);
+
+    rightSeparatorBounds = {476, 186, 180, 1};
+
+    // Pulse
+    pulseTitleBounds = {474, 194, 186, 20};
+    pulseLightBounds = {512, 199, 10, 10};
+    pulseMixKnob.setBounds(504, 224, 60, 60);
+    pulseRateKnob.setBounds(568, 224, 60, 60);
+}
+
+void NativeView::paint(juce::Graphics &g)
+{
+    const auto clip = g.getClipBounds();
+
+    // Header
+    if (clip.intersects(titleBounds))
+    {
+        g.setColour(primaryColour);
+        g.setFont(juce::Font(juce::FontOptions(titleTypeface).withHeight(64.0f)));
+        g.drawText("Oxide", titleBounds, juce::Justification::centredLeft, false);
+    }
+
+    g.setColour(textPrimary);
+    g.setFont(juce::Font(juce::FontOptions(14.0f)));
+    g.drawText("Preset:", presetBox.getBounds().translated(-62, 0).withWidth(56), juce::Justification::centredRight, false);
+
+    // Section titles and separators
+    g.setColour(primaryColour);
+    g.setFont(juce::Font(juce::FontOptions(10.0f, juce::Font::bold)));
+    g.drawText("DELAY", delayTitleBounds, juce::Justification::centredRight, false);
+    g.drawText("DISTORTION", distortionTitleBounds, juce::Justification::centredRight, false);
+    g.drawText("FILTER", filterTitleBounds, juce::Justification::centredLeft, false);
+    g.drawText("PULSE", pulseTitleBounds, juce::Justification::centredLeft, false);
+
+    g.setColour(surfaceColour);
+    g.fillRect(leftSeparatorBounds);
+    g.fillRect(rightSeparatorBounds);
+
+    // Meters
+    g.setColour(textSecondary);
+    g.setFont(juce::Font(juce::FontOptions(10.0f)));
+    g.drawText("In", meterBounds[0].getUnion(meterBounds[1]).withY(64).withHeight(14), juce::Justification::centred, false);
+    g.drawText("Out", meterBounds[2].getUnion(meterBounds[3]).withY(64).withHeight(14), juce::Justification::centred, false);
+
+    for (size_t i = 0; i < meterBounds.size(); ++i)
+    {
+        if (clip.intersects(meterBounds[i]))
+            paintMeter(g, static_cast<int>(i));
+    }
+
+    if (clip.intersects(truePeakBounds))
+    {
+        // Most delivery specs allow at most -1 dBTP
+        const float truePeak = shownLevels.outputTruePeakDb;
+        g.setColour(truePeak > -1.0f ? dangerColour : textSecondary);
+        g.drawText(truePeak <= -99.0f ? juce::String("-inf") : juce::String(truePeak, 1), truePeakBounds,
+                   juce::Justification::centred, false);
+    }
+
+    if (clip.intersects(scopeBounds))
+        paintScope(g);
+
+    if (clip.intersects(filterDisplayBounds))
+        paintFilterResponse(g);
+
+    if (clip.intersects(pulseLightBounds))
+    {
+        g.setColour(primaryColour.withAlpha(0.2f + 0.8f * shownPulseLight));
+        g.fillEllipse(pulseLightBounds.toFloat());
+    }
+}
+
+void NativeView::paintMeter(juce::Graphics &g, int index)
+{
+    const auto bounds = meterBounds[static_cast<size_t>(index)].toFloat();
+    const float height = bounds.getHeight();
+
+    g.setColour(backgroundDarker.withAlpha(0.7f));
+    g.fillRect(bounds);
+
+    // The page's gradient, fixed to the full meter height
+    juce::ColourGradient gradient(successColour, 0.0f, bounds.getBottom(), dangerColour, 0.0f, bounds.getY(), false);
+    gradient.addColour(0.55, successColour);
+    gradient.addColour(0.60, warningColour);
+    gradient.addColour(0.70, juce::Colour(0xffff3300));
+    gradient.addColour(0.75, dangerColour);
+
+    const float barHeight = height * shownLevels.bar[static_cast<size_t>(index)] / 100.0f;
+    g.setGradientFill(gradient);
+    g.fillRect(bounds.withTop(bounds.getBottom() - barHeight));
+
+    // Scale markers at the page's 0, -3, -6 and -10 dB positions
+    g.setColour(textPrimary.withAlpha(0.4f));
+    for (const float position : {0.75f, 0.60f, 0.45f, 0.25f})
+        g.fillRect(bounds.getX(), bounds.getBottom() - position * height, 4.0f, 1.0f);
+
+    const float hold = shownLevels.hold[static_cast<size_t>(index)];
+    if (hold > 0.01f)
+    {
+        g.setColour(textPrimary);
+        g.fillRect(bounds.getX(), bounds.getBottom() - height * hold / 100.0f, bounds.getWidth(), 1.0f);
+    }
+}
+
+void NativeView::paintScope(juce::Graphics &g)
+{
+    const auto area = scopeBounds.toFloat();
+    const auto centre = area.getCentre();
+    const float radius = area.getWidth() * 0.5f - 2.0f;
+    const float innerRadius = radius - 3.0f;
+
+    g.setColour(backgroundDarker.withAlpha(0.7f));
+    g.fillEllipse(area);
+
+    {
+        juce::Graphics::ScopedSaveState state(g);
+
+        juce::Path clipCircle;
+        clipCircle.addEllipse(juce::Rectangle<float>(innerRadius * 2.0f, innerRadius * 2.0f).withCentre(centre));
+        g.reduceClipRegion(clipCircle);
+
+        // 0 dB reference line
+        const float dashes[] = {2.0f, 2.0f};
+        g.setColour(juce::Colour(0xff666666));
+        g.drawDashedLine(juce::Line<float>(centre.x - innerRadius, centre.y, centre.x + innerRadius, centre.y), dashes, 2, 1.0f);
+
+        // Same amplitude curve as the page, spanning each point's min and max
+        auto scaleAmplitude = [](float value)
+        { return std::copysign(std::pow(std::abs(value), 0.8f), value) * 0.6f; };
+
+        const auto &minMax = scopeTrace.getMinMax();
+        const float firstX = centre.x - innerRadius;
+        const float waveWidth = innerRadius * 2.0f;
+
+        juce::Path wave;
+        wave.startNewSubPath(firstX, centre.y + scaleAmplitude(minMax[0]) * innerRadius);
+
+        for (int i = 0; i < ScopeTrace::numPoints; ++i)
+        {
+            const float x = firstX + static_cast<float>(i) / (ScopeTrace::numPoints - 1) * waveWidth;
+            wave.lineTo(x, centre.y + scaleAmplitude(minMax[static_cast<size_t>(i * 2)]) * innerRadius);
+            wave.lineTo(x, centre.y + scaleAmplitude(minMax[static_cast<size_t>(i * 2 + 1)]) * innerRadius);
+        }
+
+        g.setColour(primaryColour);
+        g.strokePath(wave, juce::PathStrokeType(2.0f));
+    }
+
+    g.setColour(surfaceColour);
+    g.drawEllipse(juce::Rectangle<float>(radius * 2.0f, radius * 2.0f).withCentre(centre), 3.0f);
+}
+
+void NativeView::paintFilterResponse(juce::Graphics &g)
+{
+    const auto area = filterDisplayBounds.toFloat();
+
+    g.setColour(backgroundDarker.withAlpha(0.2f));
+    g.fillRect(area);
+
+    juce::Graphics::ScopedSaveState state(g);
+    g.reduceClipRegion(filterDisplayBounds);
+
+    // Points are log spaced from 20 Hz to 20 kHz, so x is linear in the index
+    juce::Path curve;
+    for (int i = 0; i < FilterProcessor::responseSize; ++i)
+    {
+        const float x = area.getX() + static_cast<float>(i) / (FilterProcessor::responseSize - 1) * area.getWidth();
+        const float y = area.getBottom() - juce::jlimit(0.0f, 1.0f, shownResponse[static_cast<size_t>(i)]) * area.getHeight();
+
+        if (i == 0)
+            curve.startNewSubPath(x, y);
+        else
+            curve.lineTo(x, y);
+    }
+
+    g.setColour(primaryColour);
+    g.strokePath(curve, juce::PathStrokeType(2.0f));
+
+    // Frequency grid lines
+    g.setColour(textPrimary.withAlpha(0.1f));
+    for (const float frequency : {100.0f, 1000.0f, 10000.0f})
+    {
+        const float position = std::log10(frequency / 20.0f) / std::log10(1000.0f);
+        g.fillRect(area.getX() + position * area.getWidth(), area.getY(), 1.0f, area.getHeight());
+    }
+}
@@ -0,0 +1,145 @@
+#pragma once
+
+#include <JuceHeader.h>
+#include "FilterProcessor.h"
+#include "PulseProcessor.h"
+#include "ScopeFifo.h"
+#include "ScopeTrace.h"
+#include "EditorView.h"
+
+// Editor view drawn with juce::Graphics: the same controls, meters, oscilloscope and
+// filter display as the web page, without a browser. It opens in a few milliseconds and
+// costs a few MB, so it suits sessions with many instances and systems without a web
+// engine. Controls are bound straight to the parameter store, so nothing has to be
+// diffed or bridged; frames only repaint the regions whose contents moved.
+class NativeView : public EditorView
+{
+public:
+    NativeView(juce::AudioProcessorValueTreeState &parameters,
+               FilterProcessor &filterProcessor,
+               PulseProcessor &pulseProcessor,
+               ScopeFifo &scopeFifo);
+    ~NativeView() override;
+
+    void paint(juce::Graphics &g) override;
+    void resized() override;
+
+    // EditorView
+    void updateLevels(const MeterLevels &levels) override;
+    void updatePresetList(const juce::StringArray &presets) override;
+    void refreshAllParameters() override;
+    void renderFrame(bool parametersChanged) override;
+
+private:
+    // Rotary control with its name and value underneath, as on the page
+    class Knob : public juce::Component,
+                 private juce::Slider::Listener
+    {
+    public:
+        Knob(const juce::String &name, bool isSmall);
+        ~Knob() override;
+
+        void resized() override;
+
+        // Call after changing how the slider formats its value
+        void updateValueText();
+
+        juce::Slider slider;
+
+    private:
+        juce::Label nameLabel;
+        juce::Label valueLabel;
+        const bool small;
+
+        void sliderValueChanged(juce::Slider *) override;
+
+        JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(Knob)
+    };
+
+    using SliderAttachment = juce::AudioProcessorValueTreeState::SliderAttachment;
+    using ComboBoxAttachment = juce::AudioProcessorValueTreeState::ComboBoxAttachment;
+    using ButtonAttachment = juce::AudioProcessorValueTreeState::ButtonAttachment;
+
+    juce::AudioProcessorValueTreeState &parameters;
+    FilterProcessor &filterProcessor;
+    PulseProcessor &pulseProcessor;
+    ScopeFifo &scopeFifo;
+
+    // Outlives every child, so it is declared first
+    std::unique_ptr<juce::LookAndFeel> lookAndFeel;
+    juce::Typeface::Ptr titleTypeface;
+
+    // Header
+    juce::ComboBox presetBox;
+    juce::TextButton saveButton;
+    juce::TextButton viewButton;
+
+    // Delay
+    Knob delayTimeKnob;
+    Knob delayFeedbackKnob;
+    Knob delayMixKnob;
+    juce::ComboBox delayNoteBox; // "Free" turns sync off, a note value turns it on
+    juce::ToggleButton pingPongButton;
+    bool delaySyncOn = false;
+    int delayNoteIndex = 0;
+
+    // Distortion
+    Knob driveKnob;
+    Knob mixKnob;
+    juce::ComboBox algorithmBox;
+    juce::ComboBox oversamplingBox;
+
+    // Filter
+    Knob filterFrequencyKnob;
+    Knob filterResonanceKnob;
+    juce::ComboBox filterTypeBox;
+
+    // Pulse; the rate knob runs from the slowest rate to the fastest, not in enum order
+    Knob pulseMixKnob;
+    Knob pulseRateKnob;
+    std::vector<int> pulseRateByPosition;
+
+    // Meters
+    Knob inputGainKnob;
+    Knob outputGainKnob;
+
+    std::vector<std::unique_ptr<SliderAttachment>> sliderAttachments;
+    std::vector<std::unique_ptr<ComboBoxAttachment>> comboBoxAttachments;
+    std::unique_ptr<ButtonAttachment> pingPongAttachment;
+    std::unique_ptr<juce::ParameterAttachment> delaySyncAttachment;
+    std::unique_ptr<juce::ParameterAttachment> delayNoteAttachment;
+    std::unique_ptr<juce::ParameterAttachment> pulseRateAttachment;
+
+    // What is currently drawn, so frames can skip regions that did not move
+    MeterLevels shownLevels;
+    ScopeTrace scopeTrace;
+    std::array<float, FilterProcessor::responseSize> shownResponse{};
+    float shownPulseLight = 0.0f;
+
+    // Regions painted by this component rather than by children
+    juce::Rectangle<int> titleBounds;
+    std::array<juce::Rectangle<int>, 4> meterBounds;
+    juce::Rectangle<int> truePeakBounds;
+    juce::Rectangle<int> scopeBounds;
+    juce::Rectangle<int> filterDisplayBounds;
+    juce::Rectangle<int> pulseLightBounds;
+    juce::Rectangle<int> delayTitleBounds;
+    juce::Rectangle<int> distortionTitleBounds;
+    juce::Rectangle<int> filterTitleBounds;
+    juce::Rectangle<int> pulseTitleBounds;
+    juce::Rectangle<int> leftSeparatorBounds;
+    juce::Rectangle<int> rightSeparatorBounds;
+
+    void attachControls();
+    void updateDelayNoteBox();
+
+    // Redraws the filter display if the response for the stored settings moved
+    void updateFilterResponse();
+    float getPulseLight() const;
+
+    void paintMeter(juce::Graphics &g, int index);
+    void paintScope(juce::Graphics &g);
+    void paintFilterResponse(juce::Graphics &g);
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(NativeView)
+};
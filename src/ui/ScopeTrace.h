@@ -0,0 +1,78 @@
+#pragma once
+
+#include <JuceHeader.h>
+#include "ScopeFifo.h"
+
+// The oscilloscope trace both editor views draw: the most recent windowSize samples
+// from the scope FIFO, reduced to one min/max pair per display point. Message thread only.
+class ScopeTrace
+{
+public:
+    static constexpr int windowSize = 1024;
+    static constexpr int numPoints = 128;
+
+    ScopeTrace() : window(static_cast<size_t>(windowSize), 0.0f) {}
+
+    // Moves everything the audio thread has produced into the window; returns whether
+    // anything arrived. After a stall this simply cycles through the backlog and leaves
+    // the newest samples in place.
+    bool drain(ScopeFifo &fifo)
+    {
+        bool received = false;
+
+        for (;;)
+        {
+            const int numRead = fifo.pop(window.data() + writePosition, windowSize - writePosition);
+            if (numRead == 0)
+                break;
+
+            writePosition = (writePosition + numRead) % windowSize;
+            received = true;
+        }
+
+        return received;
+    }
+
+    // Recomputes the min/max pairs from the window; returns whether they changed
+    bool update()
+    {
+        constexpr int samplesPerPoint = windowSize / numPoints;
+
+        // The oldest sample sits at the write position, so walk the ring from there
+        int readPosition = writePosition;
+        bool changed = false;
+
+        for (int i = 0; i < numPoints; ++i)
+        {
+            float minimum = window[static_cast<size_t>(readPosition)];
+            float maximum = minimum;
+
+            for (int j = 0; j < samplesPerPoint; ++j)
+            {
+                const float value = window[static_cast<size_t>(readPosition)];
+                minimum = juce::jmin(minimum, value);
+                maximum = juce::jmax(maximum, value);
+                readPosition = (readPosition + 1) % windowSize;
+            }
+
+            float &storedMinimum = minMax[static_cast<size_t>(i * 2)];
+            float &storedMaximum = minMax[static_cast<size_t>(i * 2 + 1)];
+
+            changed = changed || storedMinimum != minimum || storedMaximum != maximum;
+            storedMinimum = minimum;
+            storedMaximum = maximum;
+        }
+
+        return changed;
+    }
+
+    // Interleaved min, max for each display point, oldest first
+    const std::array<float, numPoints * 2> &getMinMax() const { return minMax; }
+
+private:
+    std::vector<float> window;
+    int writePosition = 0;
+    std::array<float, numPoints * 2> minMax{};
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(ScopeTrace)
+};